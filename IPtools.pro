@@ -1,4 +1,4 @@
-QT       += core gui network
+QT       += core gui network concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -12,11 +12,32 @@ win32: DEFINES += _WIN32_WINNT=0x0600
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    benchmark.cpp \
+    handlescanner.cpp \
+    handletablemodel.cpp \
     main.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    mapsreader.cpp \
+    parallelscan.cpp \
+    processinfo.cpp \
+    procenumerator.cpp \
+    processfilter.cpp \
+    searchtask.cpp \
+    socketscanner.cpp
 
 HEADERS += \
-    mainwindow.h
+    benchmark.h \
+    handlescanner.h \
+    handletablemodel.h \
+    mainwindow.h \
+    mapsreader.h \
+    parallelscan.h \
+    processinfo.h \
+    procenumerator.h \
+    processfilter.h \
+    processtypes.h \
+    searchtask.h \
+    socketscanner.h
 
 FORMS += \
     mainwindow.ui
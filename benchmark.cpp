@@ -0,0 +1,301 @@
+#include "benchmark.h"
+#include "handlescanner.h"
+#include "mapsreader.h"
+#include "parallelscan.h"
+#include "procenumerator.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegExp>
+#include <QSet>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// 模拟的进程规模：重复枚举本机进程，直到累计访问次数达到该值
+const int kSimulatedProcesses = 50000;
+// 不会命中的进程名，测量的是纯扫描开销
+const char kMissingName[] = "no-such-process-name";
+
+struct BenchmarkResult {
+    int visits = 0;
+    qint64 elapsedNs = 0;
+
+    double nsPerProcess() const { return visits > 0 ? double(elapsedNs) / visits : 0.0; }
+};
+
+// 旧实现：QDir::entryList 枚举，再用 QFile + QTextStream 读取每个进程的 comm
+BenchmarkResult scanWithQt(int targetVisits)
+{
+    BenchmarkResult result;
+    const QString needle = QString::fromLatin1(kMissingName);
+    int matches = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    while (result.visits < targetVisits) {
+        QDir procDir("/proc");
+        const QStringList entries = procDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString &entry : entries) {
+            bool ok = false;
+            const ProcessId pid = entry.toULong(&ok);
+            if (!ok) {
+                continue;
+            }
+            ++result.visits;
+
+            QFile file(QString("/proc/%1/comm").arg(pid));
+            if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                QTextStream in(&file);
+                if (in.readLine().trimmed().contains(needle, Qt::CaseInsensitive)) {
+                    ++matches;
+                }
+            }
+        }
+        if (entries.isEmpty()) {
+            break;
+        }
+    }
+    result.elapsedNs = timer.nsecsElapsed();
+    Q_UNUSED(matches);
+    return result;
+}
+
+// 新实现：getdents64 + openat/pread，按字节匹配
+BenchmarkResult scanWithEnumerator(int targetVisits)
+{
+    BenchmarkResult result;
+    const QByteArray needle(kMissingName);
+    int matches = 0;
+    char comm[64];
+
+    QElapsedTimer timer;
+    timer.start();
+    ProcEnumerator processes;
+    while (processes.isValid() && result.visits < targetVisits) {
+        processes.rewind();
+        const int before = result.visits;
+        ProcessId pid = 0;
+        while (processes.next(&pid)) {
+            ++result.visits;
+            const int length = processes.readComm(pid, comm, int(sizeof(comm)));
+            if (length > 0 && ProcEnumerator::containsIgnoreCase(comm, length, needle)) {
+                ++matches;
+            }
+        }
+        if (result.visits == before) {
+            break;
+        }
+    }
+    result.elapsedNs = timer.nsecsElapsed();
+    Q_UNUSED(matches);
+    return result;
+}
+
+int benchmarkProcessScan(QTextStream &out)
+{
+    if (!ProcEnumerator().isValid()) {
+        out << "/proc is not available on this platform\n";
+        return 1;
+    }
+
+    // 先各跑一轮预热目录缓存
+    scanWithQt(1);
+    scanWithEnumerator(1);
+
+    const BenchmarkResult qt = scanWithQt(kSimulatedProcesses);
+    const BenchmarkResult native = scanWithEnumerator(kSimulatedProcesses);
+
+    out << "process scan: " << qt.visits << " process visits (simulating "
+        << kSimulatedProcesses << " processes)\n";
+    out << QString("  QDir + QFile/QTextStream : %1 us/process, %2 ms per %3 processes\n")
+               .arg(qt.nsPerProcess() / 1000.0, 0, 'f', 2)
+               .arg(qt.nsPerProcess() * kSimulatedProcesses / 1e6, 0, 'f', 1)
+               .arg(kSimulatedProcesses);
+    out << QString("  getdents64 + openat/pread: %1 us/process, %2 ms per %3 processes\n")
+               .arg(native.nsPerProcess() / 1000.0, 0, 'f', 2)
+               .arg(native.nsPerProcess() * kSimulatedProcesses / 1e6, 0, 'f', 1)
+               .arg(kSimulatedProcesses);
+    if (native.nsPerProcess() > 0) {
+        out << QString("  speedup: %1x\n").arg(qt.nsPerProcess() / native.nsPerProcess(), 0, 'f', 1);
+    }
+    return 0;
+}
+
+// 线程扩展性测试：以不同线程数建立全系统句柄索引（完整的 fd + maps 扫描），每种线程数取最好成绩
+const int kScanRepeats = 3;
+
+int benchmarkParallelScan(QTextStream &out)
+{
+    if (!HandleScanner::isSupported()) {
+        out << "/proc is not available on this platform\n";
+        return 1;
+    }
+
+    const int maxThreads = qMax(1, QThread::idealThreadCount());
+    QVector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.append(threads);
+    }
+    threadCounts.append(maxThreads);
+
+    // 预热目录项和 inode 缓存
+    HandleIndex::build(nullptr, maxThreads);
+
+    out << "parallel fd + maps sweep, " << ParallelScan::listProcesses().size() << " processes, "
+        << maxThreads << " hardware threads\n";
+    double baselineMs = 0;
+    for (int threads : threadCounts) {
+        qint64 bestNs = -1;
+        int handles = 0;
+        for (int i = 0; i < kScanRepeats; ++i) {
+            QElapsedTimer timer;
+            timer.start();
+            const std::shared_ptr<HandleIndex> index = HandleIndex::build(nullptr, threads);
+            const qint64 ns = timer.nsecsElapsed();
+            handles = index ? index->handleCount() : 0;
+            if (bestNs < 0 || ns < bestNs) {
+                bestNs = ns;
+            }
+        }
+        const double ms = bestNs / 1e6;
+        if (threads == 1) {
+            baselineMs = ms;
+        }
+        const double speedup = ms > 0 ? baselineMs / ms : 0.0;
+        out << QString("  %1 threads: %2 ms, %3 handles, speedup %4x, efficiency %5%\n")
+                   .arg(threads, 3)
+                   .arg(ms, 0, 'f', 2)
+                   .arg(handles)
+                   .arg(speedup, 0, 'f', 2)
+                   .arg(speedup / threads * 100.0, 0, 'f', 0);
+    }
+    return 0;
+}
+
+#ifdef Q_OS_LINUX
+// maps 基准测试中额外建立的文件映射数量，以及换算的目标规模
+const int kExtraMappings = 20000;
+const int kSimulatedMappings = 100000;
+const int kMapsIterations = 5;
+
+// 旧实现：QTextStream 逐行读取，QRegExp 切分字段，QSet<QString> 去重
+int parseMapsWithQt(ProcessId pid, int *lineCount)
+{
+    QFile file(QString("/proc/%1/maps").arg(pid));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+
+    QTextStream in(&file);
+    QSet<QString> uniquePaths;
+    while (!in.atEnd()) {
+        const QString line = in.readLine();
+        ++*lineCount;
+        const QStringList parts = line.split(QRegExp("\\s+"));
+        if (parts.size() >= 6) {
+            const QString path = parts.mid(5).join(" ").trimmed();
+            if (!path.isEmpty() && !path.startsWith("[")) {
+                uniquePaths.insert(path);
+            }
+        }
+    }
+    return uniquePaths.size();
+}
+
+int benchmarkMapsParse(QTextStream &out)
+{
+    // 把本程序文件按单页私有映射 kExtraMappings 次；各段文件偏移相同，内核不会合并它们
+    const int fd = open("/proc/self/exe", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        out << "cannot open /proc/self/exe\n";
+        return 1;
+    }
+    const size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+    QVector<void *> mappings;
+    mappings.reserve(kExtraMappings);
+    for (int i = 0; i < kExtraMappings; ++i) {
+        void *address = mmap(nullptr, pageSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            break;
+        }
+        mappings.append(address);
+    }
+    close(fd);
+
+    const ProcessId self = ProcessId(getpid());
+    int lines = 0;
+    int qtModules = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kMapsIterations; ++i) {
+        lines = 0;
+        qtModules = parseMapsWithQt(self, &lines);
+    }
+    const double qtNs = double(timer.nsecsElapsed()) / kMapsIterations;
+
+    int nativeModules = 0;
+    timer.restart();
+    for (int i = 0; i < kMapsIterations; ++i) {
+        nativeModules = MapsReader::readModules(self).size();
+    }
+    const double nativeNs = double(timer.nsecsElapsed()) / kMapsIterations;
+
+    for (void *address : mappings) {
+        munmap(address, pageSize);
+    }
+
+    if (lines == 0) {
+        out << "cannot read /proc/self/maps\n";
+        return 1;
+    }
+
+    out << "maps parse: " << lines << " mappings, modules found " << qtModules
+        << " (QRegExp) / " << nativeModules << " (MapsReader)\n";
+    out << QString("  QTextStream + QRegExp : %1 ms per read, %2 ms per %3 mappings\n")
+               .arg(qtNs / 1e6, 0, 'f', 2)
+               .arg(qtNs / lines * kSimulatedMappings / 1e6, 0, 'f', 1)
+               .arg(kSimulatedMappings);
+    out << QString("  MapsReader            : %1 ms per read, %2 ms per %3 mappings\n")
+               .arg(nativeNs / 1e6, 0, 'f', 2)
+               .arg(nativeNs / lines * kSimulatedMappings / 1e6, 0, 'f', 1)
+               .arg(kSimulatedMappings);
+    if (nativeNs > 0) {
+        out << QString("  speedup: %1x\n").arg(qtNs / nativeNs, 0, 'f', 1);
+    }
+    return 0;
+}
+#endif
+}
+
+int runBenchmark(const QString &name)
+{
+    QTextStream out(stdout);
+
+    if (name == "proc") {
+        return benchmarkProcessScan(out);
+    }
+    if (name == "scan") {
+        return benchmarkParallelScan(out);
+    }
+#ifdef Q_OS_LINUX
+    if (name == "maps") {
+        return benchmarkMapsParse(out);
+    }
+#endif
+
+    out << "available benchmarks:\n"
+        << "  proc    per-process cost of scanning /proc for a process name\n"
+        << "  maps    parsing /proc/self/maps with ~20k extra file mappings (Linux)\n"
+        << "  scan    full fd + maps sweep scaling from 1 to N threads\n";
+    return name == "list" ? 0 : 1;
+}
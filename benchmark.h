@@ -0,0 +1,10 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+
+// 命令行基准测试：IPtools --benchmark <名称>，结果输出到标准输出。
+// 名称为 list 时列出所有可用的基准测试。返回进程退出码。
+int runBenchmark(const QString &name);
+
+#endif // BENCHMARK_H
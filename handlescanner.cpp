@@ -0,0 +1,795 @@
+#include "handlescanner.h"
+#include "mapsreader.h"
+#include "parallelscan.h"
+#include "processinfo.h"
+
+#include <QFile>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const quint64 kFullRescanInterval = 10;
+
+// 逐个回调进程映射的文件 (FileId, 路径, 路径长度)，路径只在回调期间有效。
+// 同一文件的多个相邻段（代码段、数据段等）只回调一次。
+template <typename Callback>
+void forEachMappedFile(const char *pidName, Callback onMapping)
+{
+    MapsReader reader(pidName);
+    MapsEntry entry;
+    FileId last;
+    while (reader.next(&entry)) {
+        if (entry.isFileBacked() && !(entry.file == last)) {
+            last = entry.file;
+            onMapping(entry.file, entry.path, entry.pathLength);
+        }
+    }
+}
+
+// path 是否位于 prefix 之下（按路径分量边界）
+bool isUnder(const QByteArray &path, const QByteArray &prefix)
+{
+    if (prefix == "/") {
+        return path.startsWith('/');
+    }
+    return path.startsWith(prefix) && (path.size() == prefix.size() || path.at(prefix.size()) == '/');
+}
+
+QByteArray joinPath(const QByteArray &base, const QByteArray &suffix)
+{
+    if (suffix.isEmpty()) {
+        return base;
+    }
+    return base == "/" ? suffix : base + suffix;
+}
+
+// 去掉 path 中的 prefix 部分，返回 "" 或以 '/' 开头的剩余部分
+QByteArray stripPrefix(const QByteArray &path, const QByteArray &prefix)
+{
+    return prefix == "/" ? path : path.mid(prefix.size());
+}
+
+// mountinfo 中的空格等字符以 \040 形式的八进制转义
+QByteArray unescapeMountField(const QByteArray &field)
+{
+    QByteArray result;
+    result.reserve(field.size());
+    for (int i = 0; i < field.size(); ++i) {
+        if (field.at(i) == '\\' && i + 3 < field.size()) {
+            result.append(char(((field.at(i + 1) - '0') << 6) | ((field.at(i + 2) - '0') << 3) |
+                               (field.at(i + 3) - '0')));
+            i += 3;
+        } else {
+            result.append(field.at(i));
+        }
+    }
+    return result;
+}
+
+// 返回同一目录在所有挂载点下的可见路径（包含自身），用于识别绑定挂载。
+// 通过 /proc/self/mountinfo 找到目录所在挂载的设备号和文件系统内路径，
+// 再把该路径映射到同一设备的其他挂载点下。
+QVector<QByteArray> directoryAliases(const QByteArray &dirPath)
+{
+    QVector<QByteArray> aliases;
+    aliases.append(dirPath);
+
+    QFile file(QStringLiteral("/proc/self/mountinfo"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return aliases;
+    }
+
+    struct MountEntry {
+        QByteArray device;
+        QByteArray root;
+        QByteArray mountPoint;
+    };
+
+    QVector<MountEntry> mounts;
+    // mountinfo 格式: id parent major:minor root mountpoint options ...
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        const QList<QByteArray> fields = line.split(' ');
+        if (fields.size() < 5) {
+            continue;
+        }
+        MountEntry entry;
+        entry.device = fields.at(2);
+        entry.root = unescapeMountField(fields.at(3));
+        entry.mountPoint = unescapeMountField(fields.at(4));
+        mounts.append(entry);
+    }
+
+    // 最长挂载点前缀即为目录实际所在的挂载（后挂载的覆盖先挂载的）
+    int owner = -1;
+    for (int i = 0; i < mounts.size(); ++i) {
+        if (isUnder(dirPath, mounts.at(i).mountPoint) &&
+            (owner < 0 || mounts.at(i).mountPoint.size() >= mounts.at(owner).mountPoint.size())) {
+            owner = i;
+        }
+    }
+    if (owner < 0) {
+        return aliases;
+    }
+
+    const MountEntry &home = mounts.at(owner);
+    const QByteArray fsPath = joinPath(home.root, stripPrefix(dirPath, home.mountPoint));
+
+    for (int i = 0; i < mounts.size(); ++i) {
+        const MountEntry &entry = mounts.at(i);
+        if (i == owner || entry.device != home.device || !isUnder(fsPath, entry.root)) {
+            continue;
+        }
+        const QByteArray alias = joinPath(entry.mountPoint, stripPrefix(fsPath, entry.root));
+        if (!aliases.contains(alias)) {
+            aliases.append(alias);
+        }
+    }
+    return aliases;
+}
+}
+#endif
+
+void PathPrefixTrie::insert(const QByteArray &dirPath)
+{
+    if (nodes.isEmpty()) {
+        nodes.append(Node());
+    }
+
+    int current = 0;
+    const QList<QByteArray> parts = dirPath.split('/');
+    for (const QByteArray &part : parts) {
+        if (part.isEmpty()) {
+            continue;
+        }
+        int next = nodes[current].children.value(part, -1);
+        if (next < 0) {
+            next = nodes.size();
+            nodes[current].children.insert(part, next);
+            nodes.append(Node());
+        }
+        current = next;
+    }
+    nodes[current].terminal = true;
+}
+
+bool PathPrefixTrie::contains(const char *path, int length) const
+{
+    if (nodes.isEmpty() || length <= 0 || path[0] != '/') {
+        return false;
+    }
+
+    int current = 0;
+    int pos = 0;
+    while (true) {
+        if (nodes.at(current).terminal) {
+            return true;
+        }
+        while (pos < length && path[pos] == '/') {
+            ++pos;
+        }
+        if (pos >= length) {
+            return false;
+        }
+        int end = pos;
+        while (end < length && path[end] != '/') {
+            ++end;
+        }
+        // fromRawData 不复制数据，查找过程不产生堆分配
+        const QByteArray part = QByteArray::fromRawData(path + pos, end - pos);
+        const int next = nodes.at(current).children.value(part, -1);
+        if (next < 0) {
+            return false;
+        }
+        current = next;
+        pos = end;
+    }
+}
+
+HandleScanner::HandleScanner(const QString &targetPath)
+{
+    addTarget(targetPath);
+}
+
+bool HandleScanner::addTarget(const QString &targetPath)
+{
+    // 目标只解析一次，之后每个 fd 只需一次哈希查找或前缀树查找
+    FileId id;
+    QVector<QByteArray> aliases;
+    if (!resolveTarget(targetPath, &id, &aliases)) {
+        return false;
+    }
+
+    if (aliases.isEmpty()) {
+        targets.insert(id);
+    } else {
+        // 目录不遍历子树，只登记前缀；扫描代价只和系统中打开的 fd 数量有关
+        for (const QByteArray &alias : aliases) {
+            directories.insert(alias);
+        }
+    }
+    return true;
+}
+
+bool HandleScanner::resolveTarget(const QString &targetPath, FileId *fileId,
+                                  QVector<QByteArray> *directoryPaths)
+{
+    directoryPaths->clear();
+
+#ifdef Q_OS_LINUX
+    const QByteArray encoded = QFile::encodeName(targetPath);
+    struct stat st;
+    if (stat(encoded.constData(), &st) != 0) {
+        return false;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        char resolved[PATH_MAX];
+        if (!realpath(encoded.constData(), resolved)) {
+            return false;
+        }
+        *directoryPaths = directoryAliases(QByteArray(resolved));
+        return true;
+    }
+
+    fileId->device = quint64(st.st_dev);
+    fileId->inode = quint64(st.st_ino);
+    return true;
+#else
+    Q_UNUSED(targetPath);
+    Q_UNUSED(fileId);
+    return false;
+#endif
+}
+
+bool HandleScanner::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return access("/proc/self/fd", R_OK | X_OK) == 0;
+#else
+    return false;
+#endif
+}
+
+QVector<HandleScanner::Match> HandleScanner::scan()
+{
+    QVector<Match> matches;
+    scan([&matches](const Match &match) {
+        matches.append(match);
+    });
+    return matches;
+}
+
+void HandleScanner::scan(const MatchCallback &onMatch)
+{
+    processCount = 0;
+    handleCount = 0;
+    deniedCount = 0;
+    reusedCount = 0;
+    elapsed = 0;
+
+#ifdef Q_OS_LINUX
+    if (!hasTargets()) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QVector<ProcessId> pids = ParallelScan::listProcesses();
+    if (pids.isEmpty()) {
+        return;
+    }
+
+    // 增量模式下定期做一次完整扫描，兜底 fd 编号不变但指向文件已变化的情况
+    ++scanGeneration;
+    ProcessInfoCache::shared().beginScan();
+    const bool allowReuse = incremental && (scanGeneration % kFullRescanInterval) != 0;
+
+    // 每个工作线程只写自己的结果缓冲区，processStates 在并行阶段只读
+    const int workers = ParallelScan::resolveThreadCount(threadCount, pids.size());
+    QVector<WorkerResult> results(workers);
+    WorkerResult *slots = results.data();
+    const bool completed = ParallelScan::run(pids, workers, cancelFlag,
+                                             [this, allowReuse, slots](int worker, ProcessId pid) {
+        scanProcess(pid, allowReuse, &slots[worker]);
+    });
+
+    QVector<Match> matches;
+    for (const WorkerResult &result : results) {
+        processCount += result.processCount;
+        handleCount += result.handleCount;
+        deniedCount += result.deniedCount;
+        reusedCount += result.reusedCount;
+        matches += result.matches;
+        for (const ProcessState &state : result.states) {
+            processStates.insert(state.match.pid, state);
+        }
+    }
+
+    // 清理已退出进程的缓存
+    if (incremental && completed) {
+        QHash<ProcessId, ProcessState>::iterator it = processStates.begin();
+        while (it != processStates.end()) {
+            if (it->generation != scanGeneration) {
+                it = processStates.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b) {
+        return a.pid < b.pid;
+    });
+    for (const Match &match : matches) {
+        onMatch(match);
+    }
+
+    elapsed = timer.elapsed();
+#else
+    Q_UNUSED(onMatch);
+#endif
+}
+
+void HandleScanner::scanProcess(ProcessId pid, bool allowReuse, WorkerResult *result) const
+{
+#ifdef Q_OS_LINUX
+    ++result->processCount;
+
+    // 只使用栈上缓冲区，避免每个 fd 都产生堆分配
+    char pidName[24];
+    char fdDirPath[64];
+    char linkPath[96];
+    char linkTarget[PATH_MAX];
+    struct stat st;
+    const bool directoryMode = !directories.isEmpty();
+    const bool inodeMode = !targets.isEmpty();
+
+    snprintf(pidName, sizeof(pidName), "%lu", static_cast<unsigned long>(pid));
+    snprintf(fdDirPath, sizeof(fdDirPath), "/proc/%s/fd", pidName);
+    DIR *fdDir = opendir(fdDirPath);
+    if (!fdDir) {
+        if (errno == EACCES || errno == EPERM) {
+            ++result->deniedCount;
+        }
+        return;
+    }
+
+    // 先只读取目录项，收集 fd 编号并计算签名，此时还没有任何 readlink/stat
+    QVector<int> &fdNumbers = result->fdNumbers;
+    fdNumbers.clear();
+    quint64 signature = 14695981039346656037ULL;
+    while (struct dirent *fdEntry = readdir(fdDir)) {
+        if (fdEntry->d_name[0] == '.') {
+            continue;
+        }
+        const int fd = atoi(fdEntry->d_name);
+        fdNumbers.append(fd);
+        signature = (signature ^ quint64(fd)) * 1099511628211ULL;
+    }
+    closedir(fdDir);
+    result->handleCount += fdNumbers.size();
+
+    // 与 lsof +D 一致：工作目录位于目标目录内的进程同样会阻止卸载/删除
+    bool cwdInside = false;
+    if (directoryMode) {
+        snprintf(linkPath, sizeof(linkPath), "/proc/%s/cwd", pidName);
+        ssize_t len = readlink(linkPath, linkTarget, sizeof(linkTarget));
+        if (len > 0) {
+            cwdInside = directories.contains(linkTarget, int(len));
+            signature ^= qHashBits(linkTarget, size_t(len));
+        }
+    }
+
+    quint64 startTime = 0;
+    if (incremental) {
+        startTime = ProcessInfoCache::readStartTime(pid);
+        QHash<ProcessId, ProcessState>::const_iterator cached = processStates.constFind(pid);
+        if (allowReuse && cached != processStates.constEnd() && cached->startTime == startTime &&
+            cached->signature == signature) {
+            // 进程未重启且 fd 集合未变化，直接复用上一轮结果
+            ProcessState state = cached.value();
+            state.generation = scanGeneration;
+            result->states.append(state);
+            ++result->reusedCount;
+            if (!state.match.isEmpty()) {
+                result->matches.append(state.match);
+            }
+            return;
+        }
+    }
+
+    int hits = cwdInside ? 1 : 0;
+    for (int fd : fdNumbers) {
+        snprintf(linkPath, sizeof(linkPath), "%s/%d", fdDirPath, fd);
+
+        if (directoryMode) {
+            ssize_t len = readlink(linkPath, linkTarget, sizeof(linkTarget));
+            if (len > 0 && directories.contains(linkTarget, int(len))) {
+                ++hits;
+                continue;
+            }
+        }
+
+        // stat 会跟随 fd 链接，得到被打开文件的真实身份
+        if (!inodeMode || stat(linkPath, &st) != 0) {
+            continue;
+        }
+
+        FileId id;
+        id.device = quint64(st.st_dev);
+        id.inode = quint64(st.st_ino);
+        if (targets.contains(id)) {
+            ++hits;
+        }
+    }
+
+    // 内存映射：按 maps 中记录的设备号和 inode 匹配，目录模式按映射路径匹配
+    int mappings = 0;
+    forEachMappedFile(pidName, [&](const FileId &id, const char *path, int length) {
+        if ((inodeMode && targets.contains(id)) ||
+            (directoryMode && directories.contains(path, length))) {
+            ++mappings;
+        }
+    });
+
+    Match match;
+    match.pid = pid;
+    match.fdCount = hits;
+    match.mapCount = mappings;
+    if (!match.isEmpty()) {
+        const ProcessInfo info = ProcessInfoCache::shared().lookup(pid, ProcessInfo::Name | ProcessInfo::ExePath);
+        match.processName = info.name.isEmpty() ? QString::fromUtf8("未知") : info.name;
+        match.exePath = info.exePath;
+        result->matches.append(match);
+    }
+
+    if (incremental) {
+        ProcessState state;
+        state.startTime = startTime;
+        state.signature = signature;
+        state.generation = scanGeneration;
+        state.match = match;
+        result->states.append(state);
+    }
+#else
+    Q_UNUSED(pid);
+    Q_UNUSED(allowReuse);
+    Q_UNUSED(result);
+#endif
+}
+
+const quint32 HandleIndex::kNoHandle;
+
+std::shared_ptr<HandleIndex> HandleIndex::build(const QAtomicInt *cancelFlag, int threadCount)
+{
+    std::shared_ptr<HandleIndex> index(new HandleIndex());
+
+#ifdef Q_OS_LINUX
+    QElapsedTimer timer;
+    timer.start();
+
+    const QVector<ProcessId> pids = ParallelScan::listProcesses();
+    if (pids.isEmpty()) {
+        return nullptr;
+    }
+
+    ProcessInfoCache::shared().beginScan();
+
+    // 每个工作线程先建立自己的局部索引，结束后依次并入总索引
+    const int workers = ParallelScan::resolveThreadCount(threadCount, pids.size());
+    std::vector<std::unique_ptr<HandleIndex>> fragments;
+    for (int i = 0; i < workers; ++i) {
+        fragments.push_back(std::unique_ptr<HandleIndex>(new HandleIndex()));
+    }
+    std::unique_ptr<HandleIndex> *slots = fragments.data();
+    const bool completed = ParallelScan::run(pids, workers, cancelFlag,
+                                             [slots](int worker, ProcessId pid) {
+        slots[worker]->indexProcess(pid);
+    });
+    if (!completed) {
+        return nullptr;
+    }
+
+    for (const std::unique_ptr<HandleIndex> &fragment : fragments) {
+        index->merge(*fragment);
+    }
+
+    // 路径按字节序排序，目录查询即可用二分查找定位前缀区间
+    const HandleIndex *self = index.get();
+    index->pathOrder.resize(index->handles.size());
+    for (int i = 0; i < index->pathOrder.size(); ++i) {
+        index->pathOrder[i] = quint32(i);
+    }
+    std::sort(index->pathOrder.begin(), index->pathOrder.end(), [self](quint32 a, quint32 b) {
+        return self->pathAt(a) < self->pathAt(b);
+    });
+
+    index->buildElapsed = timer.elapsed();
+#else
+    Q_UNUSED(cancelFlag);
+    Q_UNUSED(threadCount);
+#endif
+
+    index->builtAt.start();
+    return index;
+}
+
+void HandleIndex::indexProcess(ProcessId pid)
+{
+#ifdef Q_OS_LINUX
+    char pidName[24];
+    char fdDirPath[64];
+    char linkPath[96];
+    char linkTarget[PATH_MAX];
+    struct stat st;
+
+    snprintf(pidName, sizeof(pidName), "%lu", static_cast<unsigned long>(pid));
+    snprintf(fdDirPath, sizeof(fdDirPath), "/proc/%s/fd", pidName);
+    DIR *fdDir = opendir(fdDirPath);
+    if (!fdDir) {
+        if (errno == EACCES || errno == EPERM) {
+            ++deniedCount;
+        }
+        return;
+    }
+
+    const quint32 processIndex = quint32(processes.size());
+    const int firstHandle = handles.size();
+
+    // 工作目录与 lsof +D 一致，同样视为占用
+    snprintf(linkPath, sizeof(linkPath), "/proc/%s/cwd", pidName);
+    ssize_t len = readlink(linkPath, linkTarget, sizeof(linkTarget));
+    if (len > 0) {
+        addHandle(processIndex, kCwdFd, linkTarget, int(len), nullptr);
+    }
+
+    while (struct dirent *fdEntry = readdir(fdDir)) {
+        if (fdEntry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(linkPath, sizeof(linkPath), "%s/%s", fdDirPath, fdEntry->d_name);
+        len = readlink(linkPath, linkTarget, sizeof(linkTarget));
+        if (len <= 0) {
+            continue;
+        }
+
+        FileId id;
+        const bool hasId = stat(linkPath, &st) == 0;
+        if (hasId) {
+            id.device = quint64(st.st_dev);
+            id.inode = quint64(st.st_ino);
+        }
+        addHandle(processIndex, atoi(fdEntry->d_name), linkTarget, int(len), hasId ? &id : nullptr);
+    }
+    closedir(fdDir);
+
+    forEachMappedFile(pidName, [this, processIndex](const FileId &id, const char *path, int length) {
+        addHandle(processIndex, kMappedFd, path, length, &id);
+    });
+
+    if (handles.size() > firstHandle) {
+        Process process;
+        process.pid = pid;
+        const ProcessInfo info = ProcessInfoCache::shared().lookup(pid,
+                                                                   ProcessInfo::Name | ProcessInfo::ExePath);
+        process.name = info.name.isEmpty() ? QString::fromUtf8("未知") : info.name;
+        process.exePath = info.exePath;
+        processes.append(process);
+    }
+#else
+    Q_UNUSED(pid);
+#endif
+}
+
+void HandleIndex::merge(const HandleIndex &fragment)
+{
+    const quint32 processBase = quint32(processes.size());
+    const quint32 handleBase = quint32(handles.size());
+    const quint32 pathBase = quint32(pathData.size());
+
+    processes += fragment.processes;
+    pathData += fragment.pathData;
+    deniedCount += fragment.deniedCount;
+
+    handles.reserve(handles.size() + fragment.handles.size());
+    for (Handle handle : fragment.handles) {
+        handle.process += processBase;
+        handle.pathOffset += pathBase;
+        if (handle.nextSameFile != kNoHandle) {
+            handle.nextSameFile += handleBase;
+        }
+        handles.append(handle);
+    }
+
+    // 局部链表整体接到总索引中同一文件的链表之前
+    for (QHash<FileId, quint32>::const_iterator it = fragment.byFileId.constBegin();
+         it != fragment.byFileId.constEnd(); ++it) {
+        const quint32 head = it.value() + handleBase;
+        QHash<FileId, quint32>::iterator existing = byFileId.find(it.key());
+        if (existing == byFileId.end()) {
+            byFileId.insert(it.key(), head);
+            continue;
+        }
+        quint32 tail = head;
+        while (handles.at(int(tail)).nextSameFile != kNoHandle) {
+            tail = handles.at(int(tail)).nextSameFile;
+        }
+        handles[int(tail)].nextSameFile = existing.value();
+        existing.value() = head;
+    }
+}
+
+void HandleIndex::addHandle(quint32 process, qint32 fd, const char *path, int length,
+                            const FileId *id)
+{
+    const quint32 handleIndex = quint32(handles.size());
+    Handle handle;
+    handle.process = process;
+    handle.fd = fd;
+    handle.pathOffset = quint32(pathData.size());
+    handle.pathLength = quint32(length);
+    pathData.append(path, length);
+
+    if (id) {
+        QHash<FileId, quint32>::iterator head = byFileId.find(*id);
+        if (head == byFileId.end()) {
+            byFileId.insert(*id, handleIndex);
+        } else {
+            handle.nextSameFile = head.value();
+            head.value() = handleIndex;
+        }
+    }
+    handles.append(handle);
+}
+
+QByteArray HandleIndex::pathAt(quint32 handle) const
+{
+    const Handle &entry = handles.at(int(handle));
+    return QByteArray::fromRawData(pathData.constData() + entry.pathOffset, int(entry.pathLength));
+}
+
+QVector<HandleScanner::Match> HandleIndex::lookup(const QString &targetPath, bool *valid) const
+{
+    QVector<HandleScanner::Match> matches;
+
+    FileId id;
+    QVector<QByteArray> directoryPaths;
+    const bool resolved = HandleScanner::resolveTarget(targetPath, &id, &directoryPaths);
+    if (valid) {
+        *valid = resolved;
+    }
+    if (!resolved) {
+        return matches;
+    }
+
+    // 进程下标 -> 命中的 fd 和映射数量
+    struct Hits {
+        int fds = 0;
+        int maps = 0;
+    };
+    QHash<quint32, Hits> hits;
+    const auto count = [this, &hits](quint32 handle) {
+        const Handle &entry = handles.at(int(handle));
+        Hits &processHits = hits[entry.process];
+        if (entry.fd == kMappedFd) {
+            ++processHits.maps;
+        } else {
+            ++processHits.fds;
+        }
+    };
+
+    if (directoryPaths.isEmpty()) {
+        quint32 handle = byFileId.value(id, kNoHandle);
+        while (handle != kNoHandle) {
+            count(handle);
+            handle = handles.at(int(handle)).nextSameFile;
+        }
+    } else {
+        QSet<quint32> seen;  // 多个别名可能互相包含，同一句柄只计一次
+        for (const QByteArray &prefix : directoryPaths) {
+            const bool root = prefix == "/";
+            QVector<quint32>::const_iterator it = std::lower_bound(
+                pathOrder.constBegin(), pathOrder.constEnd(), prefix,
+                [this](quint32 handle, const QByteArray &value) {
+                    return pathAt(handle) < value;
+                });
+            for (; it != pathOrder.constEnd(); ++it) {
+                const QByteArray path = pathAt(*it);
+                if (!path.startsWith(prefix)) {
+                    break;
+                }
+                // "/data-old" 也以 "/data" 开头，需要检查分量边界
+                if (!root && path.size() != prefix.size() && path.at(prefix.size()) != '/') {
+                    continue;
+                }
+                if (!seen.contains(*it)) {
+                    seen.insert(*it);
+                    count(*it);
+                }
+            }
+        }
+    }
+
+    QVector<quint32> order;
+    order.reserve(hits.size());
+    for (QHash<quint32, Hits>::const_iterator it = hits.constBegin(); it != hits.constEnd(); ++it) {
+        order.append(it.key());
+    }
+    std::sort(order.begin(), order.end());
+    matches.reserve(order.size());
+    for (quint32 processIndex : order) {
+        const Process &process = processes.at(int(processIndex));
+        HandleScanner::Match match;
+        match.pid = process.pid;
+        match.processName = process.name;
+        match.exePath = process.exePath;
+        const Hits processHits = hits.value(processIndex);
+        match.fdCount = processHits.fds;
+        match.mapCount = processHits.maps;
+        matches.append(match);
+    }
+    return matches;
+}
+
+qint64 HandleIndex::memoryUsage() const
+{
+    qint64 bytes = sizeof(HandleIndex);
+    bytes += qint64(processes.capacity()) * qint64(sizeof(Process));
+    for (const Process &process : processes) {
+        bytes += (process.name.capacity() + process.exePath.capacity()) * qint64(sizeof(QChar));
+    }
+    bytes += qint64(handles.capacity()) * qint64(sizeof(Handle));
+    bytes += pathData.capacity();
+    bytes += qint64(pathOrder.capacity()) * qint64(sizeof(quint32));
+    // QHash 每个节点约为 next 指针 + 哈希值 + 键值，另加桶数组
+    bytes += qint64(byFileId.size()) * qint64(sizeof(void *) + sizeof(uint) + sizeof(FileId) +
+                                              sizeof(quint32));
+    bytes += qint64(byFileId.capacity()) * qint64(sizeof(void *));
+    return bytes;
+}
+
+std::shared_ptr<const HandleIndex> HandleIndexCache::acquire(qint64 ttlMs,
+                                                             const QAtomicInt *cancelFlag,
+                                                             bool *rebuilt)
+{
+    QMutexLocker locker(&mutex);
+
+    if (rebuilt) {
+        *rebuilt = false;
+    }
+    if (current && current->ageMs() < ttlMs) {
+        return current;
+    }
+
+    // 在锁内重建，同时到达的查询等待这一次结果，不会重复扫描
+    std::shared_ptr<const HandleIndex> fresh = HandleIndex::build(cancelFlag);
+    if (!fresh) {
+        return nullptr;
+    }
+    current = fresh;
+    if (rebuilt) {
+        *rebuilt = true;
+    }
+    return current;
+}
+
+void HandleIndexCache::invalidate()
+{
+    QMutexLocker locker(&mutex);
+    current.reset();
+}
@@ -0,0 +1,205 @@
+#ifndef HANDLESCANNER_H
+#define HANDLESCANNER_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <QElapsedTimer>
+#include <QMutex>
+
+#include <functional>
+#include <memory>
+
+#include "processtypes.h"
+
+// 按路径分量组织的前缀树，用于目录子树匹配：
+// 判断一个绝对路径是否位于任一已插入目录之下，代价只与路径深度有关。
+class PathPrefixTrie
+{
+public:
+    void insert(const QByteArray &dirPath);
+    bool contains(const char *path, int length) const;
+    bool isEmpty() const { return nodes.isEmpty(); }
+
+private:
+    struct Node {
+        QHash<QByteArray, int> children;
+        bool terminal = false;
+    };
+    QVector<Node> nodes;
+};
+
+// 原生文件句柄扫描器：直接遍历 /proc/<pid>/fd，对每个 fd 做 stat，
+// 并用哈希集合按文件身份匹配目标，不再依赖 fork/exec lsof。
+// 同时解析 /proc/<pid>/maps，匹配通过 mmap 映射的文件（共享库、数据库、模型文件等）。
+// 目前仅支持 Linux。
+class HandleScanner
+{
+public:
+    struct Match {
+        ProcessId pid = 0;
+        QString processName;
+        QString exePath;
+        int fdCount = 0;   // 该进程中指向目标文件的 fd 数量
+        int mapCount = 0;  // 该进程中映射了目标文件的文件数（mmap 后即使关闭 fd 仍占用文件）
+
+        bool isEmpty() const { return fdCount == 0 && mapCount == 0; }
+    };
+
+    explicit HandleScanner(const QString &targetPath);
+
+    // 追加一个匹配目标；目标不存在时返回 false。
+    // 目标为目录时进入子树模式：匹配目录下任意文件的句柄以及工作目录位于其中的进程，
+    // 同时把同一目录在其他挂载点（绑定挂载）下的路径也加入前缀树。
+    bool addTarget(const QString &targetPath);
+    bool hasTargets() const { return !targets.isEmpty() || !directories.isEmpty(); }
+
+    // 当前系统是否可以使用原生扫描（/proc 可读）
+    static bool isSupported();
+
+    // 解析查询目标：普通文件得到 (st_dev, st_ino)，目录得到真实路径及其所有绑定挂载别名。
+    // 目标不存在时返回 false。
+    static bool resolveTarget(const QString &targetPath, FileId *fileId,
+                              QVector<QByteArray> *directoryPaths);
+
+    typedef std::function<void(const Match &)> MatchCallback;
+
+    // 设置取消标志，标志非零时扫描在下一个进程处提前结束
+    void setCancelFlag(const QAtomicInt *flag) { cancelFlag = flag; }
+
+    // 增量模式：缓存每个进程的启动时间和 fd 集合签名，再次扫描时
+    // 只对新进程或 fd 集合发生变化的进程做 readlink/stat，适合周期性监视
+    void setIncremental(bool enabled) { incremental = enabled; }
+
+    // 扫描线程数，0 表示使用 ParallelScan 的默认值
+    void setThreadCount(int count) { threadCount = count; }
+
+    // 各进程由工作窃取线程池并行扫描，结果写入各线程自己的缓冲区，
+    // 全部结束后按 PID 顺序返回或逐个回调
+    QVector<Match> scan();
+    void scan(const MatchCallback &onMatch);
+
+    // 最近一次扫描的统计信息
+    int scannedProcesses() const { return processCount; }
+    int scannedHandles() const { return handleCount; }
+    int deniedProcesses() const { return deniedCount; }
+    int reusedProcesses() const { return reusedCount; }
+    qint64 elapsedMs() const { return elapsed; }
+
+private:
+    QSet<FileId> targets;
+    PathPrefixTrie directories;
+    const QAtomicInt *cancelFlag = nullptr;
+    int processCount = 0;
+    int handleCount = 0;
+    int deniedCount = 0;
+    int reusedCount = 0;
+    qint64 elapsed = 0;
+
+    struct ProcessState {
+        quint64 startTime = 0;
+        quint64 signature = 0;
+        quint64 generation = 0;
+        Match match;  // match.pid 总是有效，即使没有命中
+    };
+
+    // 单个工作线程的扫描结果和统计，扫描结束后合并
+    struct WorkerResult {
+        QVector<Match> matches;
+        QVector<ProcessState> states;  // 增量模式下本轮各进程的新状态
+        QVector<int> fdNumbers;        // 复用的 fd 编号缓冲区
+        int processCount = 0;
+        int handleCount = 0;
+        int deniedCount = 0;
+        int reusedCount = 0;
+    };
+
+    void scanProcess(ProcessId pid, bool allowReuse, WorkerResult *result) const;
+
+    int threadCount = 0;
+    bool incremental = false;
+    quint64 scanGeneration = 0;
+    QHash<ProcessId, ProcessState> processStates;
+};
+
+// 系统级句柄倒排索引：一次遍历所有进程的 fd，建立
+// 文件身份 -> (pid, fd) 和 路径 -> (pid, fd) 两份索引。
+// 之后对任意文件或目录的查询只需一次哈希查找或一次有序区间查找。
+// 索引是某一时刻的快照，由 HandleIndexCache 按有效期负责重建。
+class HandleIndex
+{
+public:
+    // 并行扫描全部进程建立索引；threadCount 为 0 时使用默认线程数，取消时返回空指针
+    static std::shared_ptr<HandleIndex> build(const QAtomicInt *cancelFlag = nullptr,
+                                              int threadCount = 0);
+
+    // 查询占用目标的进程；目标不存在时 valid 置为 false
+    QVector<HandleScanner::Match> lookup(const QString &targetPath, bool *valid = nullptr) const;
+
+    int processCount() const { return processes.size(); }
+    int handleCount() const { return handles.size(); }
+    int deniedProcesses() const { return deniedCount; }
+    qint64 buildMs() const { return buildElapsed; }
+    qint64 ageMs() const { return builtAt.elapsed(); }
+    // 索引占用内存的估算值（字节）
+    qint64 memoryUsage() const;
+
+private:
+    HandleIndex() = default;
+
+    struct Process {
+        ProcessId pid = 0;
+        QString name;
+        QString exePath;
+    };
+
+    // 一个打开的 fd；fd 为 kCwdFd 表示进程的工作目录，只参与路径匹配，
+    // 为 kMappedFd 表示通过 mmap 映射的文件
+    enum { kCwdFd = -1, kMappedFd = -2 };
+    struct Handle {
+        quint32 process = 0;
+        qint32 fd = 0;
+        quint32 pathOffset = 0;  // 链接目标在 pathData 中的位置
+        quint32 pathLength = 0;
+        quint32 nextSameFile = kNoHandle;  // 指向同一文件的下一个句柄
+    };
+
+    static const quint32 kNoHandle = 0xffffffffu;
+
+    void addHandle(quint32 process, qint32 fd, const char *path, int length, const FileId *id);
+    // 把一个进程的句柄加入本索引（并行构建时每个工作线程各有一个局部索引）
+    void indexProcess(ProcessId pid);
+    // 并入另一个局部索引，调整下标并连接同一文件的句柄链表
+    void merge(const HandleIndex &fragment);
+    QByteArray pathAt(quint32 handle) const;
+
+    QVector<Process> processes;
+    QVector<Handle> handles;
+    QByteArray pathData;                  // 所有链接目标首尾相接存放
+    QVector<quint32> pathOrder;           // 按路径排序的句柄下标，用于目录前缀区间查找
+    QHash<FileId, quint32> byFileId;      // 文件身份 -> 第一个句柄下标，其余句柄经 nextSameFile 串联
+    int deniedCount = 0;
+    qint64 buildElapsed = 0;
+    QElapsedTimer builtAt;
+};
+
+// 带有效期的索引缓存，可在多个工作线程间共享。
+// 索引过期或被作废时，下一次查询负责重建；并发查询会等待同一次重建完成。
+class HandleIndexCache
+{
+public:
+    // 返回有效期内的索引，必要时重建；rebuilt 表示本次是否新建了索引
+    std::shared_ptr<const HandleIndex> acquire(qint64 ttlMs, const QAtomicInt *cancelFlag,
+                                               bool *rebuilt = nullptr);
+    void invalidate();
+
+private:
+    QMutex mutex;
+    std::shared_ptr<const HandleIndex> current;
+};
+
+#endif // HANDLESCANNER_H
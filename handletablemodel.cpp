@@ -0,0 +1,279 @@
+#include "handletablemodel.h"
+
+#include <QBrush>
+#include <QColor>
+#include <QPair>
+#include <QSet>
+
+namespace {
+// 以 B/KB/MB/GB 显示映射大小，0 表示不适用，显示为空
+QString formatSize(quint64 bytes)
+{
+    if (bytes == 0) {
+        return QString();
+    }
+    if (bytes < 1024) {
+        return QString("%1 B").arg(bytes);
+    }
+    const char *units[] = {"KB", "MB", "GB", "TB"};
+    double value = double(bytes) / 1024.0;
+    int unit = 0;
+    while (value >= 1024.0 && unit < 3) {
+        value /= 1024.0;
+        ++unit;
+    }
+    return QString("%1 %2").arg(value, 0, 'f', value < 10.0 ? 1 : 0).arg(units[unit]);
+}
+}
+
+HandleTableModel::HandleTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int HandleTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : pids.size();
+}
+
+int HandleTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant HandleTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= pids.size()) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+
+    if (role == Qt::BackgroundRole) {
+        switch (states.at(row)) {
+            case RowAdded:
+                return QBrush(QColor(210, 245, 210));
+            case RowRemoved:
+                return QBrush(QColor(250, 215, 215));
+            default:
+                return QVariant();
+        }
+    }
+
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole) {
+        return QVariant();
+    }
+
+    switch (index.column()) {
+        case ColumnName:
+            return strings.at(int(nameIds.at(row)));
+        case ColumnPid:
+            return QString::number(pids.at(row));
+        case ColumnPath:
+            return strings.at(int(pathIds.at(row)));
+        case ColumnKind:
+            return strings.at(int(kindIds.at(row)));
+        case ColumnSize:
+            return formatSize(mappedSizes.at(row));
+        default:
+            return QVariant();
+    }
+}
+
+QVariant HandleTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    if (orientation == Qt::Vertical) {
+        return section + 1;
+    }
+
+    switch (section) {
+        case ColumnName:
+            return QString::fromUtf8("进程名称");
+        case ColumnPid:
+            return QString::fromUtf8("PID");
+        case ColumnPath:
+            return QString::fromUtf8("进程路径");
+        case ColumnKind:
+            return QString::fromUtf8("类型");
+        case ColumnSize:
+            return QString::fromUtf8("映射大小");
+        default:
+            return QVariant();
+    }
+}
+
+void HandleTableModel::appendRows(const QVector<HandleRow> &rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    const int first = pids.size();
+    const int last = first + rows.size() - 1;
+
+    beginInsertRows(QModelIndex(), first, last);
+    for (const HandleRow &row : rows) {
+        nameIds.append(intern(row.processName));
+        pids.append(row.pid);
+        pathIds.append(intern(row.path));
+        kindIds.append(intern(row.kind));
+        mappedSizes.append(row.mappedSize);
+        states.append(RowNormal);
+    }
+    endInsertRows();
+}
+
+void HandleTableModel::applySnapshot(const QVector<HandleRow> &rows, bool markChanges,
+                                     int *addedCount, int *removedCount)
+{
+    // 1. 删除上一轮已标记为移除的行，按连续区间从后往前删除
+    int row = states.size() - 1;
+    while (row >= 0) {
+        if (states.at(row) != RowRemoved) {
+            --row;
+            continue;
+        }
+        const int last = row;
+        while (row > 0 && states.at(row - 1) == RowRemoved) {
+            --row;
+        }
+        const int count = last - row + 1;
+        beginRemoveRows(QModelIndex(), row, last);
+        nameIds.remove(row, count);
+        pids.remove(row, count);
+        pathIds.remove(row, count);
+        kindIds.remove(row, count);
+        mappedSizes.remove(row, count);
+        states.remove(row, count);
+        endRemoveRows();
+        --row;
+    }
+
+    // 2. 以 (PID, 路径) 作为行的身份
+    typedef QPair<ProcessId, quint32> RowKey;
+    QSet<RowKey> incoming;
+    incoming.reserve(rows.size());
+    for (const HandleRow &handleRow : rows) {
+        incoming.insert(qMakePair(handleRow.pid, intern(handleRow.path)));
+    }
+
+    // 3. 更新已有行状态，只对状态变化的区间发出 dataChanged
+    QSet<RowKey> existing;
+    existing.reserve(pids.size());
+    int changedFirst = -1;
+    int changedLast = -1;
+    int removed = 0;
+    for (int i = 0; i < pids.size(); ++i) {
+        const RowKey key = qMakePair(pids.at(i), pathIds.at(i));
+        existing.insert(key);
+
+        const quint8 state = incoming.contains(key) ? quint8(RowNormal) : quint8(RowRemoved);
+        if (state == RowRemoved) {
+            ++removed;
+        }
+        if (states.at(i) != state) {
+            states[i] = state;
+            if (changedFirst < 0) {
+                changedFirst = i;
+            }
+            changedLast = i;
+        }
+    }
+    if (changedFirst >= 0) {
+        emit dataChanged(index(changedFirst, 0), index(changedLast, ColumnCount - 1));
+    }
+
+    // 4. 追加新出现的行
+    QVector<HandleRow> fresh;
+    for (const HandleRow &handleRow : rows) {
+        const RowKey key = qMakePair(handleRow.pid, intern(handleRow.path));
+        if (!existing.contains(key)) {
+            existing.insert(key);
+            fresh.append(handleRow);
+        }
+    }
+
+    const int first = pids.size();
+    appendRows(fresh);
+    if (markChanges && !fresh.isEmpty()) {
+        for (int i = first; i < states.size(); ++i) {
+            states[i] = RowAdded;
+        }
+        emit dataChanged(index(first, 0), index(states.size() - 1, ColumnCount - 1));
+    }
+
+    if (addedCount) {
+        *addedCount = markChanges ? fresh.size() : 0;
+    }
+    if (removedCount) {
+        *removedCount = removed;
+    }
+}
+
+void HandleTableModel::clear()
+{
+    beginResetModel();
+    // 直接换成空容器以释放上一次查询占用的内存
+    QVector<quint32>().swap(nameIds);
+    QVector<ProcessId>().swap(pids);
+    QVector<quint32>().swap(pathIds);
+    QVector<quint32>().swap(kindIds);
+    QVector<quint64>().swap(mappedSizes);
+    QVector<quint8>().swap(states);
+    QVector<QString>().swap(strings);
+    QHash<QString, quint32>().swap(stringIds);
+    endResetModel();
+}
+
+QString HandleTableModel::processName(int row) const
+{
+    return row >= 0 && row < pids.size() ? strings.at(int(nameIds.at(row))) : QString();
+}
+
+ProcessId HandleTableModel::pid(int row) const
+{
+    return row >= 0 && row < pids.size() ? pids.at(row) : 0;
+}
+
+QString HandleTableModel::path(int row) const
+{
+    return row >= 0 && row < pids.size() ? strings.at(int(pathIds.at(row))) : QString();
+}
+
+QString HandleTableModel::kind(int row) const
+{
+    return row >= 0 && row < pids.size() ? strings.at(int(kindIds.at(row))) : QString();
+}
+
+quint64 HandleTableModel::mappedSize(int row) const
+{
+    return row >= 0 && row < pids.size() ? mappedSizes.at(row) : 0;
+}
+
+HandleRow HandleTableModel::rowAt(int row) const
+{
+    HandleRow result;
+    result.processName = processName(row);
+    result.pid = pid(row);
+    result.path = path(row);
+    result.kind = kind(row);
+    result.mappedSize = mappedSize(row);
+    return result;
+}
+
+quint32 HandleTableModel::intern(const QString &text)
+{
+    QHash<QString, quint32>::const_iterator it = stringIds.constFind(text);
+    if (it != stringIds.constEnd()) {
+        return it.value();
+    }
+
+    const quint32 id = quint32(strings.size());
+    strings.append(text);
+    stringIds.insert(text, id);
+    return id;
+}
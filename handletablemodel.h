@@ -0,0 +1,72 @@
+#ifndef HANDLETABLEMODEL_H
+#define HANDLETABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QVector>
+
+#include "processtypes.h"
+
+// 句柄/进程查询结果表模型。
+// 结果按列存放在连续数组中，进程名和路径在字符串池中去重，
+// 每行只占用三个字符串索引、一个 PID 和一个映射大小；批量追加时只发出一次插入信号。
+class HandleTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        ColumnName = 0,
+        ColumnPid,
+        ColumnKind,
+        ColumnSize,
+        ColumnPath,
+        ColumnCount
+    };
+
+    // 监视模式下行的变化状态
+    enum RowState : quint8 {
+        RowNormal = 0,
+        RowAdded,
+        RowRemoved
+    };
+
+    explicit HandleTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    void appendRows(const QVector<HandleRow> &rows);
+    void clear();
+
+    // 用一次完整的查询快照更新表格，只改动有变化的行：
+    // 上一轮标记为移除的行被删除，本轮消失的行标记为移除，新出现的行追加并标记为新增。
+    // markChanges 为 false 时作为基线，不做新增标记。
+    void applySnapshot(const QVector<HandleRow> &rows, bool markChanges,
+                       int *addedCount = nullptr, int *removedCount = nullptr);
+
+    QString processName(int row) const;
+    ProcessId pid(int row) const;
+    QString path(int row) const;
+    QString kind(int row) const;
+    quint64 mappedSize(int row) const;
+    HandleRow rowAt(int row) const;
+
+private:
+    quint32 intern(const QString &text);
+
+    QVector<quint32> nameIds;
+    QVector<ProcessId> pids;
+    QVector<quint32> pathIds;
+    QVector<quint32> kindIds;
+    QVector<quint64> mappedSizes;
+    QVector<quint8> states;
+
+    QVector<QString> strings;
+    QHash<QString, quint32> stringIds;
+};
+
+#endif // HANDLETABLEMODEL_H
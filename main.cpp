@@ -1,10 +1,18 @@
 #include "mainwindow.h"
+#include "benchmark.h"
 
 #include <QApplication>
+#include <QCoreApplication>
 #include <QTextCodec>
 
 int main(int argc, char *argv[])
 {
+    // 基准测试模式：不创建窗口，结果输出到终端
+    if (argc >= 3 && qstrcmp(argv[1], "--benchmark") == 0) {
+        QCoreApplication app(argc, argv);
+        return runBenchmark(QString::fromLocal8Bit(argv[2]));
+    }
+
     QApplication a(argc, argv);
     
     // 设置UTF-8编码
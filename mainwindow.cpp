@@ -1,5 +1,13 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "handlescanner.h"
+#include "handletablemodel.h"
+#include "mapsreader.h"
+#include "parallelscan.h"
+#include "processinfo.h"
+#include "procenumerator.h"
+#include "processfilter.h"
+#include "socketscanner.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QJsonDocument>
@@ -25,6 +33,11 @@
 #include <QRegularExpression>
 #include <QSet>
 #include <QtGlobal>
+#include <QHeaderView>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <algorithm>
 
 #ifdef Q_OS_WIN
 #ifndef _WIN32_WINNT
@@ -41,6 +54,7 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <QHash>
+#include <QMutex>
 
 namespace {
 QStringList buildLibrarySearchPaths(const QStringList &hintPaths)
@@ -99,6 +113,9 @@ QString resolveLibraryPath(const QString &libName, const QStringList &hintPaths
 
     static bool cacheInitialized = false;
     static QHash<QString, QString> ldconfigCache;
+    // 依赖查询在工作线程中执行，旧查询可能尚未退出，缓存需加锁
+    static QMutex cacheMutex;
+    QMutexLocker locker(&cacheMutex);
 
     if (!cacheInitialized) {
         cacheInitialized = true;
@@ -130,13 +147,34 @@ QString resolveLibraryPath(const QString &libName, const QStringList &hintPaths
 }
 #endif
 
+namespace {
+HandleRow rowFromMatch(const HandleScanner::Match &match)
+{
+    HandleRow row;
+    row.processName = match.processName;
+    row.pid = match.pid;
+    row.path = match.exePath.isEmpty() ? QString::fromUtf8("无法访问") : match.exePath;
+    if (match.fdCount > 0 && match.mapCount > 0) {
+        row.kind = QStringLiteral("fd+mem");
+    } else {
+        row.kind = match.mapCount > 0 ? QStringLiteral("mem") : QStringLiteral("fd");
+    }
+    return row;
+}
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , networkManager(new QNetworkAccessManager(this))
     , ipQueryManager(new QNetworkAccessManager(this))
     , locationManager(new QNetworkAccessManager(this))
-    , handleModel(new QStandardItemModel(this))
+    , handleModel(new HandleTableModel(this))
+    , handleSearch(new SearchTask(this))
+    , depsSearch(new SearchTask(this))
+    , symbolsSearch(new SearchTask(this))
+    , handleIndexCache(std::make_shared<HandleIndexCache>())
+    , watchTimer(new QTimer(this))
 {
     ui->setupUi(this);
     
@@ -148,19 +186,20 @@ MainWindow::MainWindow(QWidget *parent)
     ui->lineEditPath->setAcceptDrops(true);
     ui->lineEditPath->installEventFilter(this);
     
-    // 设置句柄查询表格模型
-    handleModel->setColumnCount(3);
-    handleModel->setHorizontalHeaderLabels(QStringList() 
-        << QString::fromUtf8("进程名称") 
-        << QString::fromUtf8("PID") 
-        << QString::fromUtf8("进程路径"));
+    // 设置句柄查询表格模型（表头由模型提供）
     ui->tableViewHandles->setModel(handleModel);
     ui->tableViewHandles->setContextMenuPolicy(Qt::CustomContextMenu);
     ui->tableViewHandles->horizontalHeader()->setStretchLastSection(true);
-    ui->tableViewHandles->setColumnWidth(0, 200);
-    ui->tableViewHandles->setColumnWidth(1, 80);
+    ui->tableViewHandles->setColumnWidth(HandleTableModel::ColumnName, 200);
+    ui->tableViewHandles->setColumnWidth(HandleTableModel::ColumnPid, 80);
+    ui->tableViewHandles->setColumnWidth(HandleTableModel::ColumnKind, 60);
+    ui->tableViewHandles->setColumnWidth(HandleTableModel::ColumnSize, 80);
     ui->tableViewHandles->setEditTriggers(QAbstractItemView::NoEditTriggers);
     ui->tableViewHandles->setSelectionBehavior(QAbstractItemView::SelectRows);
+    // 固定行高，百万行结果时视图无需逐行计算高度
+    ui->tableViewHandles->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->tableViewHandles->verticalHeader()->setDefaultSectionSize(
+        ui->tableViewHandles->fontMetrics().height() + 6);
     
     // 设置文本框右键菜单
     ui->textEditDeps->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -174,6 +213,26 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->textEditSymbols, &QTextEdit::customContextMenuRequested,
             this, &MainWindow::showTextEditContextMenu);
     
+    // 监视模式定时器
+    watchTimer->setInterval(ui->spinBoxWatchInterval->value() * 1000);
+    connect(watchTimer, &QTimer::timeout, this, &MainWindow::onWatchTimeout);
+
+    // 连接后台查询信号
+    connect(handleSearch, &SearchTask::rowsReady,
+            this, &MainWindow::onHandleRowsReady);
+    connect(handleSearch, &SearchTask::finished,
+            this, &MainWindow::onHandleSearchFinished);
+    connect(depsSearch, &SearchTask::textCleared,
+            ui->textEditDeps, &QTextEdit::clear);
+    connect(depsSearch, &SearchTask::linesReady, this, [this](const QStringList &lines) {
+        ui->textEditDeps->append(lines.join('\n'));
+    });
+    connect(symbolsSearch, &SearchTask::textCleared,
+            ui->textEditSymbols, &QTextEdit::clear);
+    connect(symbolsSearch, &SearchTask::linesReady, this, [this](const QStringList &lines) {
+        ui->textEditSymbols->append(lines.join('\n'));
+    });
+    
     // 连接网络请求信号
     connect(networkManager, &QNetworkAccessManager::finished,
             this, &MainWindow::onMyIPReplyFinished);
@@ -230,11 +289,118 @@ void MainWindow::on_btnSearchHandle_clicked()
 // 刷新句柄查询
 void MainWindow::on_btnRefreshHandle_clicked()
 {
+    // 刷新时强制重建句柄索引
+    handleIndexCache->invalidate();
+
     if (!ui->lineEditPath->text().isEmpty()) {
         on_btnSearchHandle_clicked();
     }
 }
 
+// 开启/关闭监视模式
+void MainWindow::on_checkBoxWatch_toggled(bool checked)
+{
+    if (!checked) {
+        watchTimer->stop();
+        abortWatchScan();
+        watchScanner.reset();
+        return;
+    }
+
+    if (ui->lineEditPath->text().trimmed().isEmpty()) {
+        QMessageBox::warning(this, 
+            QString::fromUtf8("警告"), 
+            QString::fromUtf8("请输入文件路径！"));
+        ui->checkBoxWatch->setChecked(false);
+        return;
+    }
+
+    // 从空表开始，第一轮扫描作为基线
+    handleSearch->cancel();
+    handleModel->clear();
+    watchScanner.reset();
+    watchBaseline = true;
+    watchTimer->start();
+    startWatchScan();
+}
+
+void MainWindow::on_spinBoxWatchInterval_valueChanged(int seconds)
+{
+    watchTimer->setInterval(seconds * 1000);
+}
+
+// 扫描线程数，0 表示按 CPU 核数自动选择，对之后开始的扫描生效
+void MainWindow::on_spinBoxScanThreads_valueChanged(int threads)
+{
+    ParallelScan::setDefaultThreadCount(threads);
+}
+
+void MainWindow::onWatchTimeout()
+{
+    // 上一轮扫描尚未结束时跳过本次
+    if (!handleSearch->isRunning()) {
+        startWatchScan();
+    }
+}
+
+// 启动一轮监视扫描：复用增量扫描器，只重新检查新进程和 fd 集合变化的进程
+void MainWindow::startWatchScan()
+{
+    const QString path = ui->lineEditPath->text().trimmed();
+    if (path.isEmpty()) {
+        return;
+    }
+
+    if (!watchScanner || path != watchPath) {
+        if (watchScanner) {
+            // 路径变化后旧结果不再有意义
+            handleModel->clear();
+        }
+        watchBaseline = true;
+        watchScanner = std::make_shared<HandleScanner>(path);
+        watchScanner->setIncremental(true);
+        watchPath = path;
+    }
+
+    watchRows.clear();
+    watchScanActive = true;
+
+    std::shared_ptr<HandleScanner> scanner = watchScanner;
+    handleSearch->start([path, scanner](SearchContext &context) {
+        if (!HandleScanner::isSupported() || !scanner->hasTargets()) {
+            // 非 Linux 平台或目标无法 stat 时退回普通查询
+            collectFileHandles(path, context);
+            return;
+        }
+
+        scanner->setCancelFlag(context.cancelFlag());
+        int foundCount = 0;
+        scanner->scan([&context, &foundCount](const HandleScanner::Match &match) {
+            context.addRow(rowFromMatch(match));
+            ++foundCount;
+        });
+
+        SearchOutcome &outcome = context.outcome();
+        outcome.foundCount = foundCount;
+        outcome.status = QString::fromUtf8("扫描 %1 个进程，复用 %2 个，耗时 %3 ms")
+            .arg(scanner->scannedProcesses())
+            .arg(scanner->reusedProcesses())
+            .arg(scanner->elapsedMs());
+    });
+}
+
+// 放弃正在进行的监视扫描。被取消的扫描可能仍在工作线程中使用扫描器，
+// 因此同时丢弃扫描器，下一轮重新建立，避免两个线程共用同一份增量状态。
+void MainWindow::abortWatchScan()
+{
+    if (watchScanActive) {
+        watchScanActive = false;
+        watchScanner.reset();
+        watchBaseline = true;
+    }
+    watchRows.clear();
+}
+
 // 获取本机公网IP
 void MainWindow::on_btnGetMyIP_clicked()
 {
@@ -358,14 +524,86 @@ void MainWindow::onIPLocationReplyFinished(QNetworkReply *reply)
 // 搜索文件句柄
 void MainWindow::searchFileHandles(const QString &path)
 {
-    handleModel->removeRows(0, handleModel->rowCount());
+    abortWatchScan();
+    handleModel->clear();
     ui->labelHandleStatus->setText(QString::fromUtf8("正在搜索..."));
-    
+
+    // 在后台线程执行，结果分批送回表格，新的查询会取消上一次查询
+    if (ui->checkBoxUseIndex->isChecked() && HandleScanner::isSupported()) {
+        std::shared_ptr<HandleIndexCache> cache = handleIndexCache;
+        const qint64 ttlMs = qint64(ui->spinBoxIndexTtl->value()) * 1000;
+        handleSearch->start([path, cache, ttlMs](SearchContext &context) {
+            collectIndexedHandles(path, cache, ttlMs, context);
+        });
+        return;
+    }
+
+    handleSearch->start([path](SearchContext &context) {
+        collectFileHandles(path, context);
+    });
+}
+
+// 从句柄索引查询：有效期内只做一次哈希/区间查找，过期时先重建索引
+void MainWindow::collectIndexedHandles(const QString &path,
+                                       const std::shared_ptr<HandleIndexCache> &cache,
+                                       qint64 ttlMs, SearchContext &context)
+{
+    bool rebuilt = false;
+    std::shared_ptr<const HandleIndex> index = cache->acquire(ttlMs, context.cancelFlag(), &rebuilt);
+    if (!index) {
+        return;
+    }
+
+    QElapsedTimer lookupTimer;
+    lookupTimer.start();
+    bool valid = false;
+    const QVector<HandleScanner::Match> matches = index->lookup(path, &valid);
+    const qint64 lookupUs = lookupTimer.nsecsElapsed() / 1000;
+
+    if (!valid) {
+        // 目标无法解析时交给常规查询处理（包括 lsof 后备）
+        collectFileHandles(path, context);
+        return;
+    }
+
+    for (const HandleScanner::Match &match : matches) {
+        context.addRow(rowFromMatch(match));
+    }
+
+    SearchOutcome &outcome = context.outcome();
+    outcome.foundCount = matches.size();
+    outcome.status = QString::fromUtf8("搜索完成，找到 %1 个相关进程（索引查询 %2 微秒）｜"
+                                       "索引%3：%4 个进程 / %5 个句柄，约 %6 KB，构建耗时 %7 ms，%8 秒后过期")
+        .arg(matches.size())
+        .arg(lookupUs)
+        .arg(rebuilt ? QString::fromUtf8("已重建") : QString())
+        .arg(index->processCount())
+        .arg(index->handleCount())
+        .arg((index->memoryUsage() + 1023) / 1024)
+        .arg(index->buildMs())
+        .arg(qMax<qint64>(0, (ttlMs - index->ageMs()) / 1000));
+
+    if (matches.isEmpty()) {
+        QString hint = QString::fromUtf8("未找到占用该路径的进程。\n索引为 %1 秒前的快照，可点击“刷新”重建。")
+            .arg(index->ageMs() / 1000);
+        if (index->deniedProcesses() > 0) {
+            hint += QString::fromUtf8("\n提示：有 %1 个进程无权限访问，可使用 root 权限重试。")
+                .arg(index->deniedProcesses());
+        }
+        outcome.setMessage(SearchOutcome::Information, QString::fromUtf8("提示"), hint);
+    }
+}
+
+void MainWindow::collectFileHandles(const QString &path, SearchContext &context)
+{
+    SearchOutcome &outcome = context.outcome();
+
 #ifdef Q_OS_WIN
     
     HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (snapshot == INVALID_HANDLE_VALUE) {
-        QMessageBox::critical(this, 
+        outcome.status = QString::fromUtf8("查询失败");
+        outcome.setMessage(SearchOutcome::Critical,
             QString::fromUtf8("错误"), 
             QString::fromUtf8("无法创建进程快照！"));
         return;
@@ -378,6 +616,10 @@ void MainWindow::searchFileHandles(const QString &path)
     
     if (Process32FirstW(snapshot, &pe32)) {
         do {
+            if (context.isCanceled()) {
+                break;
+            }
+
             DWORD processId = pe32.th32ProcessID;
             
             // 打开进程
@@ -398,14 +640,11 @@ void MainWindow::searchFileHandles(const QString &path)
                     if (procPath.contains(targetPath, Qt::CaseInsensitive) ||
                         targetPath.contains(procPath, Qt::CaseInsensitive)) {
                         
-                        QString processName = QString::fromWCharArray(pe32.szExeFile);
-                        
-                        QList<QStandardItem*> rowItems;
-                        rowItems << new QStandardItem(processName);
-                        rowItems << new QStandardItem(QString::number(processId));
-                        rowItems << new QStandardItem(procPath);
-                        
-                        handleModel->appendRow(rowItems);
+                        HandleRow row;
+                        row.processName = QString::fromWCharArray(pe32.szExeFile);
+                        row.pid = processId;
+                        row.path = procPath;
+                        context.addRow(row);
                         foundCount++;
                     }
                 }
@@ -417,21 +656,51 @@ void MainWindow::searchFileHandles(const QString &path)
     
     CloseHandle(snapshot);
     
-    ui->labelHandleStatus->setText(
-        QString::fromUtf8("搜索完成，找到 %1 个相关进程").arg(foundCount));
+    outcome.foundCount = foundCount;
+    outcome.status = QString::fromUtf8("搜索完成，找到 %1 个相关进程").arg(foundCount);
     
     if (foundCount == 0) {
-        QMessageBox::information(this, 
+        outcome.setMessage(SearchOutcome::Information,
             QString::fromUtf8("提示"), 
             QString::fromUtf8("未找到占用该文件的进程。\n注意：需要管理员权限才能检测所有进程。"));
     }
     
 #elif defined(Q_OS_LINUX)
-    // Linux 使用 lsof 命令查找文件占用
+    QFileInfo targetInfo(path);
+
+    // 优先使用原生 /proc 扫描，避免 fork lsof 以及 10 秒超时
+    HandleScanner scanner(path);
+    if (HandleScanner::isSupported() && scanner.hasTargets()) {
+        scanner.setCancelFlag(context.cancelFlag());
+
+        int foundCount = 0;
+        scanner.scan([&context, &foundCount](const HandleScanner::Match &match) {
+            context.addRow(rowFromMatch(match));
+            ++foundCount;
+        });
+
+        outcome.foundCount = foundCount;
+        outcome.status = QString::fromUtf8("搜索完成，找到 %1 个相关进程（扫描 %2 个进程 / %3 个句柄，耗时 %4 ms）")
+            .arg(foundCount)
+            .arg(scanner.scannedProcesses())
+            .arg(scanner.scannedHandles())
+            .arg(scanner.elapsedMs());
+
+        if (foundCount == 0) {
+            QString hint = QString::fromUtf8("未找到占用该路径的进程。");
+            if (scanner.deniedProcesses() > 0) {
+                hint += QString::fromUtf8("\n提示：有 %1 个进程无权限访问，可使用 root 权限重试。")
+                    .arg(scanner.deniedProcesses());
+            }
+            outcome.setMessage(SearchOutcome::Information, QString::fromUtf8("提示"), hint);
+        }
+        return;
+    }
+
+    // /proc 不可用时，回退到 lsof 命令查找文件占用
     int foundCount = 0;
     
     QProcess process;
-    QFileInfo targetInfo(path);
     QString targetPath = targetInfo.absoluteFilePath();
     QStringList arguments;
 
@@ -444,10 +713,24 @@ void MainWindow::searchFileHandles(const QString &path)
 
     process.start("lsof", arguments);
 
-    if (!process.waitForFinished(10000)) {
+    // 分段等待，以便新的查询能及时取消当前 lsof
+    QElapsedTimer lsofTimer;
+    lsofTimer.start();
+    while (!process.waitForFinished(100)) {
+        if (context.isCanceled() || lsofTimer.elapsed() >= 10000 ||
+            process.state() == QProcess::NotRunning) {
+            break;
+        }
+    }
+
+    if (process.state() != QProcess::NotRunning) {
         process.kill();
-        ui->labelHandleStatus->setText(QString::fromUtf8("lsof 执行超时"));
-        QMessageBox::warning(this,
+        process.waitForFinished(1000);
+        if (context.isCanceled()) {
+            return;
+        }
+        outcome.status = QString::fromUtf8("lsof 执行超时");
+        outcome.setMessage(SearchOutcome::Warning,
             QString::fromUtf8("超时"),
             QString::fromUtf8("lsof 查询耗时过长，已取消。请缩小查询范围或以 root 权限重试。"));
         return;
@@ -459,6 +742,10 @@ void MainWindow::searchFileHandles(const QString &path)
 
     if (!output.trimmed().isEmpty()) {
         QStringList lines = output.split('\n', QString::SkipEmptyParts);
+
+        // 同一进程每打开一个文件就占一行，exe 链接经缓存只解析一次
+        ProcessInfoCache &processInfo = ProcessInfoCache::shared();
+        processInfo.beginScan();
         
         for (int i = 1; i < lines.size(); ++i) {  // 跳过标题行
             QStringList parts = lines[i].split(QRegExp("\\s+"), QString::SkipEmptyParts);
@@ -469,26 +756,27 @@ void MainWindow::searchFileHandles(const QString &path)
                 ProcessId pid = pidStr.toULong(&ok);
                 
                 if (ok) {
-                    QString procPath = QString("/proc/%1/exe").arg(pid);
-                    QFileInfo fi(procPath);
-                    QString exePath = fi.symLinkTarget();
+                    QString exePath = processInfo.exePath(pid);
+                    // FD 列为 mem/txt 表示内存映射或程序文本，其余为打开的文件描述符
+                    const QString fdColumn = parts.size() >= 4 ? parts[3] : QString();
                     
-                    QList<QStandardItem*> rowItems;
-                    rowItems << new QStandardItem(processName);
-                    rowItems << new QStandardItem(pidStr);
-                    rowItems << new QStandardItem(exePath.isEmpty() ? QString::fromUtf8("无法访问") : exePath);
-                    
-                    handleModel->appendRow(rowItems);
+                    HandleRow row;
+                    row.processName = processName;
+                    row.pid = pid;
+                    row.path = exePath.isEmpty() ? QString::fromUtf8("无法访问") : exePath;
+                    row.kind = (fdColumn == "mem" || fdColumn == "txt")
+                        ? QStringLiteral("mem") : QStringLiteral("fd");
+                    context.addRow(row);
                     foundCount++;
                 }
             }
         }
 
-        ui->labelHandleStatus->setText(
-            QString::fromUtf8("搜索完成，找到 %1 个相关进程").arg(foundCount));
+        outcome.foundCount = foundCount;
+        outcome.status = QString::fromUtf8("搜索完成，找到 %1 个相关进程").arg(foundCount);
 
         if (foundCount == 0) {
-            QMessageBox::information(this, 
+            outcome.setMessage(SearchOutcome::Information,
                 QString::fromUtf8("提示"), 
                 QString::fromUtf8("未找到占用该路径的进程。\n提示：可能需要 root 权限或安装 lsof 工具。"));
         } else if (exitCode != 0) {
@@ -498,7 +786,7 @@ void MainWindow::searchFileHandles(const QString &path)
                     .arg(exitCode);
             }
 
-            QMessageBox::information(this,
+            outcome.setMessage(SearchOutcome::Information,
                 QString::fromUtf8("部分结果"),
                 QString::fromUtf8("lsof 返回了部分结果，但伴随以下警告：\n%1\n\n信息可能不完整，建议使用 sudo 重新执行或排除无法访问的挂载点。")
                     .arg(warningMsg));
@@ -507,8 +795,8 @@ void MainWindow::searchFileHandles(const QString &path)
         if (errorText.trimmed().isEmpty()) {
             errorText = QString::fromUtf8("lsof 返回代码: %1").arg(exitCode);
         }
-        ui->labelHandleStatus->setText(QString::fromUtf8("查询失败"));
-        QMessageBox::warning(this,
+        outcome.status = QString::fromUtf8("查询失败");
+        outcome.setMessage(SearchOutcome::Warning,
             QString::fromUtf8("查询失败"),
             QString::fromUtf8("无法执行 lsof 查询：%1\n请确认已安装 lsof，并具有足够权限。")
                 .arg(errorText));
@@ -516,13 +804,70 @@ void MainWindow::searchFileHandles(const QString &path)
     
 #else
     Q_UNUSED(path);
-    ui->labelHandleStatus->setText(QString::fromUtf8("此平台暂不支持"));
-    QMessageBox::information(this, 
+    outcome.status = QString::fromUtf8("此平台暂不支持");
+    outcome.setMessage(SearchOutcome::Information,
         QString::fromUtf8("提示"), 
         QString::fromUtf8("此功能暂不支持当前平台！"));
 #endif
 }
 
+// 后台查询送回的一批结果行
+void MainWindow::onHandleRowsReady(const QVector<HandleRow> &rows)
+{
+    // 监视扫描先收集完整快照，结束后再与表格做差异比较
+    if (watchScanActive) {
+        watchRows += rows;
+        return;
+    }
+
+    handleModel->appendRows(rows);
+
+    ui->labelHandleStatus->setText(
+        QString::fromUtf8("正在搜索... 已找到 %1 条结果").arg(handleModel->rowCount()));
+}
+
+// 后台查询结束
+void MainWindow::onHandleSearchFinished(const SearchOutcome &outcome)
+{
+    if (watchScanActive) {
+        watchScanActive = false;
+
+        int added = 0;
+        int removed = 0;
+        handleModel->applySnapshot(watchRows, !watchBaseline, &added, &removed);
+        watchBaseline = false;
+        watchRows.clear();
+
+        // 监视模式下不弹出提示框，只更新状态栏
+        ui->labelHandleStatus->setText(
+            QString::fromUtf8("监视中（每 %1 秒）：%2 个相关进程，新增 %3，移除 %4｜%5")
+                .arg(ui->spinBoxWatchInterval->value())
+                .arg(outcome.foundCount)
+                .arg(added)
+                .arg(removed)
+                .arg(outcome.status));
+        return;
+    }
+
+    if (!outcome.status.isEmpty()) {
+        ui->labelHandleStatus->setText(outcome.status);
+    }
+
+    switch (outcome.level) {
+        case SearchOutcome::Information:
+            QMessageBox::information(this, outcome.messageTitle, outcome.messageText);
+            break;
+        case SearchOutcome::Warning:
+            QMessageBox::warning(this, outcome.messageTitle, outcome.messageText);
+            break;
+        case SearchOutcome::Critical:
+            QMessageBox::critical(this, outcome.messageTitle, outcome.messageText);
+            break;
+        case SearchOutcome::NoMessage:
+            break;
+    }
+}
+
 QString MainWindow::getProcessName(ProcessId processId)
 {
 #ifdef Q_OS_WIN
@@ -538,15 +883,8 @@ QString MainWindow::getProcessName(ProcessId processId)
     }
     return QString::fromUtf8("未知");
 #elif defined(Q_OS_LINUX)
-    QString cmdlinePath = QString("/proc/%1/comm").arg(processId);
-    QFile file(cmdlinePath);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString name = in.readLine().trimmed();
-        file.close();
-        return name.isEmpty() ? QString::fromUtf8("未知") : name;
-    }
-    return QString::fromUtf8("未知");
+    QString name = ProcessInfoCache::shared().name(processId).trimmed();
+    return name.isEmpty() ? QString::fromUtf8("未知") : name;
 #else
     Q_UNUSED(processId);
     return QString::fromUtf8("未知");
@@ -581,10 +919,10 @@ bool MainWindow::killProcess(ProcessId processId)
 #endif
 }
 
-// 获取进程加载的模块（DLL和文件）
-QStringList MainWindow::getProcessModules(ProcessId processId)
+// 获取进程加载的模块（DLL和文件）及其映射大小
+QVector<ProcessModule> MainWindow::getProcessModules(ProcessId processId)
 {
-    QStringList modules;
+    QVector<ProcessModule> modules;
     
 #ifdef Q_OS_WIN
     HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, processId);
@@ -597,33 +935,24 @@ QStringList MainWindow::getProcessModules(ProcessId processId)
             for (unsigned int i = 0; i < (cbNeeded / sizeof(HMODULE)); i++) {
                 wchar_t szModName[MAX_PATH];
                 if (GetModuleFileNameExW(hProcess, hMods[i], szModName, MAX_PATH)) {
-                    modules.append(QString::fromWCharArray(szModName));
+                    ProcessModule module;
+                    module.path = QString::fromWCharArray(szModName);
+                    MODULEINFO info;
+                    if (GetModuleInformation(hProcess, hMods[i], &info, sizeof(info))) {
+                        module.start = quint64(reinterpret_cast<quintptr>(info.lpBaseOfDll));
+                        module.end = module.start + info.SizeOfImage;
+                        module.mappedSize = info.SizeOfImage;
+                        module.segmentCount = 1;
+                    }
+                    modules.append(module);
                 }
             }
         }
         CloseHandle(hProcess);
     }
 #elif defined(Q_OS_LINUX)
-    QString mapsPath = QString("/proc/%1/maps").arg(processId);
-    QFile file(mapsPath);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QSet<QString> uniquePaths;  // 使用Set去重
-        
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            // maps 格式: address perms offset dev inode pathname
-            QStringList parts = line.split(QRegExp("\\s+"));
-            if (parts.size() >= 6) {
-                QString path = parts.mid(5).join(" ").trimmed();
-                if (!path.isEmpty() && !path.startsWith("[")) {
-                    uniquePaths.insert(path);
-                }
-            }
-        }
-        file.close();
-        modules = uniquePaths.toList();
-    }
+    // 流式解析 maps，按 (设备号, inode) 去重，同一文件的多个段合并为一个模块
+    modules = MapsReader::readModules(processId);
 #else
     Q_UNUSED(processId);
 #endif
@@ -691,11 +1020,11 @@ void MainWindow::showContextMenu(const QPoint &pos)
     QAction *selectedAction = contextMenu.exec(ui->tableViewHandles->viewport()->mapToGlobal(pos));
     
     if (selectedAction == copyProcessAction) {
-        copySelectedColumn(0);
+        copySelectedColumn(HandleTableModel::ColumnName);
     } else if (selectedAction == copyPidAction) {
-        copySelectedColumn(1);
+        copySelectedColumn(HandleTableModel::ColumnPid);
     } else if (selectedAction == copyPathAction) {
-        copySelectedColumn(2);
+        copySelectedColumn(HandleTableModel::ColumnPath);
     } else if (selectedAction == copyRowAction) {
         copySelectedRow();
     } else if (selectedAction == killAction) {
@@ -714,8 +1043,8 @@ void MainWindow::killSelectedProcess()
     }
     
     int row = selection.first().row();
-    QString processName = handleModel->item(row, 0)->text();
-    QString pidStr = handleModel->item(row, 1)->text();
+    QString processName = handleModel->processName(row);
+    QString pidStr = QString::number(handleModel->pid(row));
     
     QMessageBox::StandardButton reply;
     reply = QMessageBox::question(this,
@@ -769,8 +1098,7 @@ void MainWindow::copySelectedRow()
     int row = selection.first().row();
     QStringList parts;
     for (int col = 0; col < handleModel->columnCount(); ++col) {
-        QStandardItem *item = handleModel->item(row, col);
-        parts << (item ? item->text() : QString());
+        parts << handleModel->index(row, col).data().toString();
     }
 
     QString text = parts.join("\t");
@@ -856,6 +1184,15 @@ void MainWindow::on_btnSearchProcess_clicked()
             QString::fromUtf8("请输入进程名称或PID！"));
         return;
     }
+
+#ifdef Q_OS_LINUX
+    // 先校验过滤表达式，避免清空结果后才报错
+    ProcessFilter filter;
+    if (!filter.parse(input)) {
+        QMessageBox::warning(this, QString::fromUtf8("警告"), filter.errorString());
+        return;
+    }
+#endif
     
     searchProcessFiles(input);
 }
@@ -863,16 +1200,29 @@ void MainWindow::on_btnSearchProcess_clicked()
 // 查询进程打开的文件
 void MainWindow::searchProcessFiles(const QString &processNameOrPid)
 {
-    handleModel->removeRows(0, handleModel->rowCount());
+    // 监视只针对路径查询，切换到进程查询时关闭
+    ui->checkBoxWatch->setChecked(false);
+    abortWatchScan();
+    handleModel->clear();
     ui->labelHandleStatus->setText(QString::fromUtf8("正在搜索进程..."));
-    
+
+    handleSearch->start([processNameOrPid](SearchContext &context) {
+        collectProcessFiles(processNameOrPid, context);
+    });
+}
+
+void MainWindow::collectProcessFiles(const QString &processNameOrPid, SearchContext &context)
+{
+    SearchOutcome &outcome = context.outcome();
+
 #ifdef Q_OS_WIN
     bool isPid = false;
     DWORD targetPid = processNameOrPid.toULong(&isPid);
     
     HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (snapshot == INVALID_HANDLE_VALUE) {
-        QMessageBox::critical(this,
+        outcome.status = QString::fromUtf8("查询失败");
+        outcome.setMessage(SearchOutcome::Critical,
             QString::fromUtf8("错误"),
             QString::fromUtf8("无法创建进程快照！"));
         return;
@@ -885,6 +1235,10 @@ void MainWindow::searchProcessFiles(const QString &processNameOrPid)
     
     if (Process32FirstW(snapshot, &pe32)) {
         do {
+            if (context.isCanceled()) {
+                break;
+            }
+
             bool match = false;
             
             // 判断是否匹配
@@ -900,17 +1254,17 @@ void MainWindow::searchProcessFiles(const QString &processNameOrPid)
                 QString processName = QString::fromWCharArray(pe32.szExeFile);
                 
                 // 获取进程加载的所有模块
-                QStringList modules = getProcessModules(processId);
+                const QVector<ProcessModule> modules = getProcessModules(processId);
                 
                 if (!modules.isEmpty()) {
                     // 为每个模块添加一行
-                    for (const QString &modulePath : modules) {
-                        QList<QStandardItem*> rowItems;
-                        rowItems << new QStandardItem(processName);
-                        rowItems << new QStandardItem(QString::number(processId));
-                        rowItems << new QStandardItem(modulePath);
-                        
-                        handleModel->appendRow(rowItems);
+                    for (const ProcessModule &module : modules) {
+                        HandleRow row;
+                        row.processName = processName;
+                        row.pid = processId;
+                        row.path = module.path;
+                        row.mappedSize = module.mappedSize;
+                        context.addRow(row);
                         foundCount++;
                     }
                 } else {
@@ -921,12 +1275,11 @@ void MainWindow::searchProcessFiles(const QString &processNameOrPid)
                         DWORD pathLen = GetModuleFileNameExW(hProcess, NULL, processPath, MAX_PATH);
                         
                         if (pathLen > 0) {
-                            QList<QStandardItem*> rowItems;
-                            rowItems << new QStandardItem(processName);
-                            rowItems << new QStandardItem(QString::number(processId));
-                            rowItems << new QStandardItem(QString::fromWCharArray(processPath));
-                            
-                            handleModel->appendRow(rowItems);
+                            HandleRow row;
+                            row.processName = processName;
+                            row.pid = processId;
+                            row.path = QString::fromWCharArray(processPath);
+                            context.addRow(row);
                             foundCount++;
                         }
                         
@@ -939,88 +1292,245 @@ void MainWindow::searchProcessFiles(const QString &processNameOrPid)
     
     CloseHandle(snapshot);
     
-    ui->labelHandleStatus->setText(
-        QString::fromUtf8("搜索完成，找到 %1 个文件/模块").arg(foundCount));
+    outcome.foundCount = foundCount;
+    outcome.status = QString::fromUtf8("搜索完成，找到 %1 个文件/模块").arg(foundCount);
     
     if (foundCount == 0) {
-        QMessageBox::information(this,
+        outcome.setMessage(SearchOutcome::Information,
             QString::fromUtf8("提示"),
             QString::fromUtf8("未找到匹配的进程或无法访问进程信息。\n注意：需要管理员权限才能查看所有进程。"));
     }
     
 #elif defined(Q_OS_LINUX)
-    // Linux 通过 /proc 查找进程
-    bool isPid = false;
-    ProcessId targetPid = processNameOrPid.toULong(&isPid);
-    int foundCount = 0;
-    
-    QDir procDir("/proc");
-    QStringList entries = procDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &entry : entries) {
-        bool ok;
-        ProcessId pid = entry.toULong(&ok);
-        if (!ok) continue;
-        
-        QString processName = getProcessName(pid);
-        bool match = false;
-        
-        if (isPid) {
-            match = (pid == targetPid);
-        } else {
-            match = processName.contains(processNameOrPid, Qt::CaseInsensitive);
+    // Linux 通过 /proc 查找进程：各进程在工作窃取线程池中并行检查，过滤条件按读取代价从低到高求值，
+    // 只有通过全部条件的进程才会读取 maps 并构造 QString
+    ProcessFilter filter;
+    if (!filter.parse(processNameOrPid)) {
+        outcome.status = QString::fromUtf8("过滤条件无效");
+        outcome.setMessage(SearchOutcome::Warning, QString::fromUtf8("警告"), filter.errorString());
+        return;
+    }
+
+    QElapsedTimer scanTimer;
+    scanTimer.start();
+
+    ProcEnumerator processes;
+    ProcessInfoCache &processInfo = ProcessInfoCache::shared();
+    processInfo.beginScan();
+
+    // 按 PID 查询时不需要遍历 /proc
+    const QVector<ProcessId> pids = filter.hasPid()
+        ? QVector<ProcessId>(1, filter.pid())
+        : ParallelScan::listProcesses();
+
+    // 各工作线程只写自己的结果缓冲区，结束后合并
+    struct WorkerRows {
+        QVector<HandleRow> rows;
+        int matchedCount = 0;
+    };
+    const int workers = ParallelScan::resolveThreadCount(0, pids.size());
+    QVector<WorkerRows> results(workers);
+    WorkerRows *slots = results.data();
+
+    ParallelScan::run(pids, workers, context.cancelFlag(), [&](int worker, ProcessId pid) {
+        ProcessFilter::Candidate candidate;
+        if (!filter.matches(processes, pid, &candidate)) {
+            return;
         }
+        WorkerRows &result = slots[worker];
+        ++result.matchedCount;
+
+        const QString processName = candidate.nameLength > 0
+            ? QString::fromLocal8Bit(candidate.name, candidate.nameLength)
+            : QString::fromUtf8("未知");
+
+        const QVector<ProcessModule> modules = getProcessModules(pid);
         
-        if (match) {
-            QStringList modules = getProcessModules(pid);
+        if (!modules.isEmpty()) {
+            for (const ProcessModule &module : modules) {
+                HandleRow row;
+                row.processName = processName;
+                row.pid = pid;
+                row.path = module.path;
+                row.kind = "mem";
+                row.mappedSize = module.mappedSize;
+                result.rows.append(row);
+            }
+        } else {
+            // 至少显示进程主路径
+            QString path = processInfo.exePath(pid);
             
-            if (!modules.isEmpty()) {
-                for (const QString &modulePath : modules) {
-                    QList<QStandardItem*> rowItems;
-                    rowItems << new QStandardItem(processName);
-                    rowItems << new QStandardItem(QString::number(pid));
-                    rowItems << new QStandardItem(modulePath);
-                    
-                    handleModel->appendRow(rowItems);
-                    foundCount++;
-                }
-            } else {
-                // 至少显示进程主路径
-                QString exePath = QString("/proc/%1/exe").arg(pid);
-                QFileInfo fi(exePath);
-                QString path = fi.symLinkTarget();
-                
-                if (!path.isEmpty()) {
-                    QList<QStandardItem*> rowItems;
-                    rowItems << new QStandardItem(processName);
-                    rowItems << new QStandardItem(QString::number(pid));
-                    rowItems << new QStandardItem(path);
-                    
-                    handleModel->appendRow(rowItems);
-                    foundCount++;
-                }
+            if (!path.isEmpty()) {
+                HandleRow row;
+                row.processName = processName;
+                row.pid = pid;
+                row.path = path;
+                result.rows.append(row);
             }
         }
+    });
+
+    QVector<HandleRow> rows;
+    int matchedCount = 0;
+    for (const WorkerRows &result : results) {
+        rows += result.rows;
+        matchedCount += result.matchedCount;
+    }
+    std::stable_sort(rows.begin(), rows.end(), [](const HandleRow &a, const HandleRow &b) {
+        return a.pid < b.pid;
+    });
+    for (const HandleRow &row : rows) {
+        context.addRow(row);
     }
+    const int foundCount = rows.size();
+    const int scannedCount = pids.size();
     
-    ui->labelHandleStatus->setText(
-        QString::fromUtf8("搜索完成，找到 %1 个文件/模块").arg(foundCount));
+    outcome.foundCount = foundCount;
+    outcome.status = QString::fromUtf8("搜索完成，找到 %1 个文件/模块（扫描 %2 个进程，匹配 %3 个，耗时 %4 ms）")
+        .arg(foundCount)
+        .arg(scannedCount)
+        .arg(matchedCount)
+        .arg(scanTimer.elapsed());
     
     if (foundCount == 0) {
-        QMessageBox::information(this,
+        outcome.setMessage(SearchOutcome::Information,
             QString::fromUtf8("提示"),
             QString::fromUtf8("未找到匹配的进程或无法访问进程信息。\n注意：可能需要 root 权限才能查看所有进程。"));
     }
     
 #else
     Q_UNUSED(processNameOrPid);
-    ui->labelHandleStatus->setText(QString::fromUtf8("此平台暂不支持"));
-    QMessageBox::information(this,
+    outcome.status = QString::fromUtf8("此平台暂不支持");
+    outcome.setMessage(SearchOutcome::Information,
         QString::fromUtf8("提示"),
         QString::fromUtf8("此功能暂不支持当前平台！"));
 #endif
 }
 
+// 查询端口
+void MainWindow::on_btnSearchPort_clicked()
+{
+    QString input = ui->lineEditPort->text().trimmed();
+    quint16 port = 0;
+
+    if (!input.isEmpty()) {
+        bool ok = false;
+        const uint value = input.toUInt(&ok);
+        if (!ok || value == 0 || value > 65535) {
+            QMessageBox::warning(this,
+                QString::fromUtf8("警告"),
+                QString::fromUtf8("请输入 1-65535 之间的端口号！"));
+            return;
+        }
+        port = quint16(value);
+    }
+
+    searchSockets(port, QString());
+}
+
+// 查看进程的连接表
+void MainWindow::on_btnProcessConnections_clicked()
+{
+    QString input = ui->lineEditProcess->text().trimmed();
+
+    if (input.isEmpty()) {
+        QMessageBox::warning(this,
+            QString::fromUtf8("警告"),
+            QString::fromUtf8("请输入进程名称或PID！"));
+        return;
+    }
+
+    searchSockets(0, input);
+}
+
+// 查询套接字及其所属进程：指定进程时列出其全部连接，否则按端口查询
+void MainWindow::searchSockets(quint16 port, const QString &processNameOrPid)
+{
+    ui->checkBoxWatch->setChecked(false);
+    abortWatchScan();
+    handleModel->clear();
+    ui->labelHandleStatus->setText(processNameOrPid.isEmpty()
+        ? QString::fromUtf8("正在查询端口...")
+        : QString::fromUtf8("正在查询连接..."));
+
+    handleSearch->start([port, processNameOrPid](SearchContext &context) {
+        collectSockets(port, processNameOrPid, context);
+    });
+}
+
+void MainWindow::collectSockets(quint16 port, const QString &processNameOrPid,
+                                SearchContext &context)
+{
+    SearchOutcome &outcome = context.outcome();
+
+    if (!SocketScanner::isSupported()) {
+        outcome.status = QString::fromUtf8("此平台暂不支持");
+        outcome.setMessage(SearchOutcome::Information,
+            QString::fromUtf8("提示"),
+            QString::fromUtf8("端口查询需要读取 /proc/net，当前平台暂不支持！"));
+        return;
+    }
+
+    SocketScanner scanner(port);
+    if (!processNameOrPid.isEmpty()) {
+        scanner.setProcessFilter(processNameOrPid);
+    }
+    scanner.setCancelFlag(context.cancelFlag());
+    scanner.scan([&context](const SocketScanner::Match &match) {
+        HandleRow row;
+        row.processName = match.processName;
+        row.pid = match.pid;
+        row.path = match.socket.describe();
+        row.kind = QStringLiteral("socket");
+        if (!match.exePath.isEmpty()) {
+            row.path += QString::fromUtf8("  ｜  ") + match.exePath;
+        }
+        context.addRow(row);
+    });
+
+    QString backend;
+    switch (scanner.backend()) {
+        case SocketScanner::Netlink:
+            backend = QStringLiteral("netlink");
+            break;
+        case SocketScanner::Procfs:
+            backend = QStringLiteral("/proc/net");
+            break;
+        case SocketScanner::Mixed:
+            backend = QStringLiteral("netlink + /proc/net");
+            break;
+    }
+
+    const int foundCount = scanner.matchedSockets();
+    outcome.foundCount = foundCount;
+    outcome.status = QString::fromUtf8("查询完成，找到 %1 个套接字（%2：读取 %3 个套接字 / 扫描 %4 个进程，耗时 %5 ms）")
+        .arg(foundCount)
+        .arg(backend)
+        .arg(scanner.socketCount())
+        .arg(scanner.scannedProcesses())
+        .arg(scanner.elapsedMs());
+    if (scanner.orphanSockets() > 0) {
+        outcome.status += QString::fromUtf8("，另有 %1 个无归属套接字（如 TIME_WAIT 或无权限访问的进程）")
+            .arg(scanner.orphanSockets());
+    }
+
+    if (foundCount == 0) {
+        QString hint;
+        if (!processNameOrPid.isEmpty()) {
+            hint = QString::fromUtf8("未找到进程 %1 的网络连接。").arg(processNameOrPid);
+        } else if (port == 0) {
+            hint = QString::fromUtf8("未找到监听中的端口。");
+        } else {
+            hint = QString::fromUtf8("未找到使用端口 %1 的进程。").arg(port);
+        }
+        if (scanner.deniedProcesses() > 0) {
+            hint += QString::fromUtf8("\n提示：有 %1 个进程无权限访问，可使用 root 权限重试。")
+                .arg(scanner.deniedProcesses());
+        }
+        outcome.setMessage(SearchOutcome::Information, QString::fromUtf8("提示"), hint);
+    }
+}
+
 // 浏览二进制文件
 void MainWindow::on_btnBrowseBinary_clicked()
 {
@@ -1092,7 +1602,14 @@ void MainWindow::queryDependencies(const QString &filePath)
 {
     ui->textEditDeps->clear();
     ui->textEditDeps->append(QString::fromUtf8("正在查询依赖库...\n"));
-    
+
+    depsSearch->start([filePath](SearchContext &context) {
+        collectDependencies(filePath, context);
+    });
+}
+
+void MainWindow::collectDependencies(const QString &filePath, SearchContext &context)
+{
 #ifdef Q_OS_LINUX
     struct DependencyInfo {
         QString name;
@@ -1240,44 +1757,44 @@ void MainWindow::queryDependencies(const QString &filePath)
         }
     }
 
-    ui->textEditDeps->clear();
-    ui->textEditDeps->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-    ui->textEditDeps->append(QString::fromUtf8("║              依赖库列表                        ║"));
-    ui->textEditDeps->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+    context.clearText();
+    context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+    context.addLine(QString::fromUtf8("║              依赖库列表                        ║"));
+    context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
 
     if (!dependencies.isEmpty()) {
         int index = 1;
         for (const DependencyInfo &info : dependencies) {
-            ui->textEditDeps->append(QString::fromUtf8("%1. %2")
+            context.addLine(QString::fromUtf8("%1. %2")
                 .arg(index)
                 .arg(info.name));
             if (!info.path.isEmpty()) {
-                ui->textEditDeps->append(QString::fromUtf8("    ➜ %1")
+                context.addLine(QString::fromUtf8("    ➜ %1")
                     .arg(info.path));
             }
             if (!info.note.isEmpty()) {
-                ui->textEditDeps->append(QStringLiteral("    %1").arg(info.note));
+                context.addLine(QStringLiteral("    %1").arg(info.note));
             }
-            ui->textEditDeps->append(QString());
+            context.addLine(QString());
             ++index;
         }
 
-        ui->textEditDeps->append(QString::fromUtf8("════════════════════════════════════════════════"));
-        ui->textEditDeps->append(QString::fromUtf8("✅ 共找到 %1 个依赖项")
+        context.addLine(QString::fromUtf8("════════════════════════════════════════════════"));
+        context.addLine(QString::fromUtf8("✅ 共找到 %1 个依赖项")
             .arg(dependencies.size()));
     } else {
         if (staticBinary) {
-            ui->textEditDeps->append(QString::fromUtf8("⚠ 该文件似乎为静态链接或不包含动态依赖。"));
+            context.addLine(QString::fromUtf8("⚠ 该文件似乎为静态链接或不包含动态依赖。"));
         } else {
-            ui->textEditDeps->append(QString::fromUtf8("❌ 未能解析出任何依赖项。"));
+            context.addLine(QString::fromUtf8("❌ 未能解析出任何依赖项。"));
         }
     }
 
     if (!warnings.isEmpty()) {
-        ui->textEditDeps->append(QString());
-        ui->textEditDeps->append(QString::fromUtf8("⚠ 提示/警告:"));
+        context.addLine(QString());
+        context.addLine(QString::fromUtf8("⚠ 提示/警告:"));
         for (const QString &warning : warnings) {
-            ui->textEditDeps->append(QStringLiteral("- %1").arg(warning));
+            context.addLine(QStringLiteral("- %1").arg(warning));
         }
     }
 
@@ -1293,33 +1810,33 @@ void MainWindow::queryDependencies(const QString &filePath)
     if (!process.waitForFinished(5000)) {
         process.kill();
         // 如果dumpbin不可用，提示用户
-        ui->textEditDeps->clear();
-        ui->textEditDeps->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-        ui->textEditDeps->append(QString::fromUtf8("║              依赖库列表                        ║"));
-        ui->textEditDeps->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
-        ui->textEditDeps->append(QString::fromUtf8("⚠ Windows平台需要安装 Visual Studio 的 dumpbin 工具"));
-        ui->textEditDeps->append(QString::fromUtf8("\n💡 提示："));
-        ui->textEditDeps->append(QString::fromUtf8("1. 安装 Visual Studio（包含 C++ 开发工具）"));
-        ui->textEditDeps->append(QString::fromUtf8("2. 使用 Developer Command Prompt 运行本程序"));
-        ui->textEditDeps->append(QString::fromUtf8("3. 或使用第三方工具如 Dependency Walker"));
+        context.clearText();
+        context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+        context.addLine(QString::fromUtf8("║              依赖库列表                        ║"));
+        context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+        context.addLine(QString::fromUtf8("⚠ Windows平台需要安装 Visual Studio 的 dumpbin 工具"));
+        context.addLine(QString::fromUtf8("\n💡 提示："));
+        context.addLine(QString::fromUtf8("1. 安装 Visual Studio（包含 C++ 开发工具）"));
+        context.addLine(QString::fromUtf8("2. 使用 Developer Command Prompt 运行本程序"));
+        context.addLine(QString::fromUtf8("3. 或使用第三方工具如 Dependency Walker"));
         return;
     }
     
     QString output = QString::fromLocal8Bit(process.readAllStandardOutput());
     
     if (!output.isEmpty()) {
-        ui->textEditDeps->clear();
-        ui->textEditDeps->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-        ui->textEditDeps->append(QString::fromUtf8("║              依赖库列表                        ║"));
-        ui->textEditDeps->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
-        ui->textEditDeps->append(output);
+        context.clearText();
+        context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+        context.addLine(QString::fromUtf8("║              依赖库列表                        ║"));
+        context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+        context.addLine(output);
     } else {
-        ui->textEditDeps->append(QString::fromUtf8("\n❌ 无法获取依赖信息，请确保 dumpbin 工具可用"));
+        context.addLine(QString::fromUtf8("\n❌ 无法获取依赖信息，请确保 dumpbin 工具可用"));
     }
     
 #else
-    ui->textEditDeps->clear();
-    ui->textEditDeps->append(QString::fromUtf8("⚠ 此平台暂不支持依赖查询功能"));
+    context.clearText();
+    context.addLine(QString::fromUtf8("⚠ 此平台暂不支持依赖查询功能"));
 #endif
 }
 
@@ -1328,7 +1845,14 @@ void MainWindow::querySymbols(const QString &filePath)
 {
     ui->textEditSymbols->clear();
     ui->textEditSymbols->append(QString::fromUtf8("正在查询符号表...\n"));
-    
+
+    symbolsSearch->start([filePath](SearchContext &context) {
+        collectSymbols(filePath, context);
+    });
+}
+
+void MainWindow::collectSymbols(const QString &filePath, SearchContext &context)
+{
 #ifdef Q_OS_LINUX
     // 先尝试查询动态符号（导出的函数）
     QProcess process;
@@ -1336,7 +1860,7 @@ void MainWindow::querySymbols(const QString &filePath)
     
     if (!process.waitForFinished(10000)) {
         process.kill();
-        ui->textEditSymbols->append(QString::fromUtf8("\n❌ 查询超时"));
+        context.addLine(QString::fromUtf8("\n❌ 查询超时"));
         return;
     }
     
@@ -1344,10 +1868,10 @@ void MainWindow::querySymbols(const QString &filePath)
     QString errorText = QString::fromLocal8Bit(process.readAllStandardError());
     
     if (!output.isEmpty()) {
-        ui->textEditSymbols->clear();
-        ui->textEditSymbols->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-        ui->textEditSymbols->append(QString::fromUtf8("║           动态符号表（导出函数）               ║"));
-        ui->textEditSymbols->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+        context.clearText();
+        context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+        context.addLine(QString::fromUtf8("║           动态符号表（导出函数）               ║"));
+        context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
         
         QStringList lines = output.split('\n', QString::SkipEmptyParts);
         int funcCount = 0;
@@ -1361,23 +1885,23 @@ void MainWindow::querySymbols(const QString &filePath)
                 
                 // T/t = 代码段符号（函数）, D/d = 数据段符号
                 if (type == "T" || type == "t") {
-                    ui->textEditSymbols->append(QString::fromUtf8("🔵 [函数] %1").arg(symbol));
+                    context.addLine(QString::fromUtf8("🔵 [函数] %1").arg(symbol));
                     funcCount++;
                 } else if (type == "D" || type == "d" || type == "B" || type == "b") {
-                    ui->textEditSymbols->append(QString::fromUtf8("🟢 [数据] %1").arg(symbol));
+                    context.addLine(QString::fromUtf8("🟢 [数据] %1").arg(symbol));
                     dataCount++;
                 } else {
-                    ui->textEditSymbols->append(QString::fromUtf8("⚪ [其他] %1 (%2)").arg(symbol).arg(type));
+                    context.addLine(QString::fromUtf8("⚪ [其他] %1 (%2)").arg(symbol).arg(type));
                 }
             }
         }
         
-        ui->textEditSymbols->append(QString::fromUtf8("\n════════════════════════════════════════════════"));
-        ui->textEditSymbols->append(QString::fromUtf8("✅ 统计: %1 个函数, %2 个数据符号")
+        context.addLine(QString::fromUtf8("\n════════════════════════════════════════════════"));
+        context.addLine(QString::fromUtf8("✅ 统计: %1 个函数, %2 个数据符号")
             .arg(funcCount).arg(dataCount));
         
         if (!errorText.isEmpty() && !errorText.contains("no symbols")) {
-            ui->textEditSymbols->append(QString::fromUtf8("\n⚠ 警告: %1").arg(errorText));
+            context.addLine(QString::fromUtf8("\n⚠ 警告: %1").arg(errorText));
         }
     } else {
         // 如果没有动态符号，尝试查看所有符号
@@ -1387,30 +1911,30 @@ void MainWindow::querySymbols(const QString &filePath)
         output = QString::fromLocal8Bit(process.readAllStandardOutput());
         
         if (!output.isEmpty()) {
-            ui->textEditSymbols->clear();
-            ui->textEditSymbols->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-            ui->textEditSymbols->append(QString::fromUtf8("║              所有符号表                        ║"));
-            ui->textEditSymbols->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
-            ui->textEditSymbols->append(QString::fromUtf8("⚠ 注意：这是静态链接的可执行文件，显示所有符号\n"));
+            context.clearText();
+            context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+            context.addLine(QString::fromUtf8("║              所有符号表                        ║"));
+            context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+            context.addLine(QString::fromUtf8("⚠ 注意：这是静态链接的可执行文件，显示所有符号\n"));
             
             QStringList lines = output.split('\n', QString::SkipEmptyParts);
             int count = 0;
             for (const QString &line : lines) {
                 if (count < 1000) {  // 限制显示数量
-                    ui->textEditSymbols->append(line);
+                    context.addLine(line);
                     count++;
                 }
             }
             
             if (lines.size() > 1000) {
-                ui->textEditSymbols->append(QString::fromUtf8("\n... (共 %1 个符号，仅显示前 1000 个)")
+                context.addLine(QString::fromUtf8("\n... (共 %1 个符号，仅显示前 1000 个)")
                     .arg(lines.size()));
             }
         } else {
-            ui->textEditSymbols->append(QString::fromUtf8("\n❌ 无符号信息"));
-            ui->textEditSymbols->append(QString::fromUtf8("提示：文件可能已被 strip 或不是有效的二进制文件"));
+            context.addLine(QString::fromUtf8("\n❌ 无符号信息"));
+            context.addLine(QString::fromUtf8("提示：文件可能已被 strip 或不是有效的二进制文件"));
             if (!errorText.isEmpty()) {
-                ui->textEditSymbols->append(QString::fromUtf8("\n错误: %1").arg(errorText));
+                context.addLine(QString::fromUtf8("\n错误: %1").arg(errorText));
             }
         }
     }
@@ -1424,34 +1948,34 @@ void MainWindow::querySymbols(const QString &filePath)
     
     if (!process.waitForFinished(10000)) {
         process.kill();
-        ui->textEditSymbols->clear();
-        ui->textEditSymbols->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-        ui->textEditSymbols->append(QString::fromUtf8("║           导出函数列表                         ║"));
-        ui->textEditSymbols->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
-        ui->textEditSymbols->append(QString::fromUtf8("⚠ Windows平台需要安装 Visual Studio 的 dumpbin 工具"));
-        ui->textEditSymbols->append(QString::fromUtf8("\n💡 提示："));
-        ui->textEditSymbols->append(QString::fromUtf8("1. 安装 Visual Studio（包含 C++ 开发工具）"));
-        ui->textEditSymbols->append(QString::fromUtf8("2. 使用 Developer Command Prompt 运行本程序"));
-        ui->textEditSymbols->append(QString::fromUtf8("3. 或使用第三方工具如 CFF Explorer"));
+        context.clearText();
+        context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+        context.addLine(QString::fromUtf8("║           导出函数列表                         ║"));
+        context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+        context.addLine(QString::fromUtf8("⚠ Windows平台需要安装 Visual Studio 的 dumpbin 工具"));
+        context.addLine(QString::fromUtf8("\n💡 提示："));
+        context.addLine(QString::fromUtf8("1. 安装 Visual Studio（包含 C++ 开发工具）"));
+        context.addLine(QString::fromUtf8("2. 使用 Developer Command Prompt 运行本程序"));
+        context.addLine(QString::fromUtf8("3. 或使用第三方工具如 CFF Explorer"));
         return;
     }
     
     QString output = QString::fromLocal8Bit(process.readAllStandardOutput());
     
     if (!output.isEmpty()) {
-        ui->textEditSymbols->clear();
-        ui->textEditSymbols->append(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
-        ui->textEditSymbols->append(QString::fromUtf8("║           导出函数列表                         ║"));
-        ui->textEditSymbols->append(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
-        ui->textEditSymbols->append(output);
+        context.clearText();
+        context.addLine(QString::fromUtf8("╔═══════════════════════════════════════════════╗"));
+        context.addLine(QString::fromUtf8("║           导出函数列表                         ║"));
+        context.addLine(QString::fromUtf8("╚═══════════════════════════════════════════════╝\n"));
+        context.addLine(output);
     } else {
-        ui->textEditSymbols->append(QString::fromUtf8("\n❌ 无法获取导出函数信息"));
-        ui->textEditSymbols->append(QString::fromUtf8("提示：该文件可能没有导出任何函数，或 dumpbin 工具不可用"));
+        context.addLine(QString::fromUtf8("\n❌ 无法获取导出函数信息"));
+        context.addLine(QString::fromUtf8("提示：该文件可能没有导出任何函数，或 dumpbin 工具不可用"));
     }
     
 #else
-    ui->textEditSymbols->clear();
-    ui->textEditSymbols->append(QString::fromUtf8("⚠ 此平台暂不支持符号查询功能"));
+    context.clearText();
+    context.addLine(QString::fromUtf8("⚠ 此平台暂不支持符号查询功能"));
 #endif
 }
 
@@ -4,17 +4,19 @@
 #include <QMainWindow>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QStandardItemModel>
 #include <QMenu>
 
-class QEvent;
+#include <memory>
+
+#include "processtypes.h"
+#include "searchtask.h"
 
-#ifdef Q_OS_WIN
-#include <windows.h>
-typedef DWORD ProcessId;
-#else
-typedef unsigned long ProcessId;
-#endif
+class HandleIndexCache;
+class HandleScanner;
+class HandleTableModel;
+class QTimer;
+
+class QEvent;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -37,6 +39,12 @@ private slots:
     void on_btnBrowse_clicked();
     void on_btnRefreshHandle_clicked();
     void on_btnSearchProcess_clicked();
+    void on_btnSearchPort_clicked();
+    void on_btnProcessConnections_clicked();
+    void on_checkBoxWatch_toggled(bool checked);
+    void on_spinBoxWatchInterval_valueChanged(int seconds);
+    void on_spinBoxScanThreads_valueChanged(int threads);
+    void onWatchTimeout();
     
     // 右键菜单
     void showContextMenu(const QPoint &pos);
@@ -57,25 +65,57 @@ private slots:
     void on_btnQueryDeps_clicked();
     void on_btnQuerySymbols_clicked();
 
+    // 后台查询结果
+    void onHandleRowsReady(const QVector<HandleRow> &rows);
+    void onHandleSearchFinished(const SearchOutcome &outcome);
+
 private:
     Ui::MainWindow *ui;
     QNetworkAccessManager *networkManager;
     QNetworkAccessManager *ipQueryManager;
     QNetworkAccessManager *locationManager;
-    QStandardItemModel *handleModel;
+    HandleTableModel *handleModel;
+    SearchTask *handleSearch;
+    SearchTask *depsSearch;
+    SearchTask *symbolsSearch;
+
+    // 句柄索引缓存，工作线程与界面线程共享
+    std::shared_ptr<HandleIndexCache> handleIndexCache;
+
+    // 监视模式
+    QTimer *watchTimer;
+    std::shared_ptr<HandleScanner> watchScanner;
+    QString watchPath;
+    QVector<HandleRow> watchRows;
+    bool watchScanActive = false;
+    bool watchBaseline = true;
     
     // 辅助函数
     QString getLocalIPAddresses();
     void searchFileHandles(const QString &path);
     void searchProcessFiles(const QString &processNameOrPid);
-    QString getProcessName(ProcessId processId);
+    void searchSockets(quint16 port, const QString &processNameOrPid);
+    void startWatchScan();
+    void abortWatchScan();
+    static QString getProcessName(ProcessId processId);
     bool isFileInUse(const QString &filePath, ProcessId processId);
     bool killProcess(ProcessId processId);
-    QStringList getProcessModules(ProcessId processId);
+    static QVector<ProcessModule> getProcessModules(ProcessId processId);
     
     // 依赖分析辅助函数
     void queryDependencies(const QString &filePath);
     void querySymbols(const QString &filePath);
+
+    // 在工作线程中执行的查询主体，不访问任何界面对象
+    static void collectFileHandles(const QString &path, SearchContext &context);
+    static void collectIndexedHandles(const QString &path,
+                                      const std::shared_ptr<HandleIndexCache> &cache,
+                                      qint64 ttlMs, SearchContext &context);
+    static void collectProcessFiles(const QString &processNameOrPid, SearchContext &context);
+    static void collectSockets(quint16 port, const QString &processNameOrPid,
+                               SearchContext &context);
+    static void collectDependencies(const QString &filePath, SearchContext &context);
+    static void collectSymbols(const QString &filePath, SearchContext &context);
 };
 #endif // MAINWINDOW_H
 
@@ -0,0 +1,247 @@
+#include "mapsreader.h"
+
+#include <QHash>
+#include <QString>
+
+#include <string.h>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace {
+const char *parseHex(const char *p, const char *end, quint64 *value)
+{
+    quint64 result = 0;
+    for (; p < end; ++p) {
+        unsigned digit = unsigned(*p - '0');
+        if (digit > 9) {
+            digit = unsigned((*p | 0x20) - 'a');
+            if (digit > 5) {
+                break;
+            }
+            digit += 10;
+        }
+        result = (result << 4) | digit;
+    }
+    *value = result;
+    return p;
+}
+
+const char *parseDecimal(const char *p, const char *end, quint64 *value)
+{
+    quint64 result = 0;
+    for (; p < end && unsigned(*p - '0') <= 9; ++p) {
+        result = result * 10 + unsigned(*p - '0');
+    }
+    *value = result;
+    return p;
+}
+
+inline const char *skipSpaces(const char *p, const char *end)
+{
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    return p;
+}
+
+// 格式: address perms offset dev inode pathname
+bool parseLine(const char *p, const char *end, MapsEntry *entry)
+{
+    p = parseHex(p, end, &entry->start);
+    if (p >= end || *p != '-') {
+        return false;
+    }
+    p = parseHex(p + 1, end, &entry->end);
+    p = skipSpaces(p, end);
+
+    if (end - p < 4) {
+        return false;
+    }
+    memcpy(entry->perms, p, 4);
+    entry->perms[4] = '\0';
+    p = skipSpaces(p + 4, end);
+
+    p = parseHex(p, end, &entry->offset);
+    p = skipSpaces(p, end);
+
+    quint64 major = 0;
+    quint64 minor = 0;
+    p = parseHex(p, end, &major);
+    if (p >= end || *p != ':') {
+        return false;
+    }
+    p = parseHex(p + 1, end, &minor);
+    p = skipSpaces(p, end);
+
+    quint64 inode = 0;
+    p = parseDecimal(p, end, &inode);
+    p = skipSpaces(p, end);
+
+    entry->file.device = inode != 0 ? quint64(makedev(major, minor)) : 0;
+    entry->file.inode = inode;
+    entry->path = p;
+    entry->pathLength = int(end - p);
+    return true;
+}
+}
+#endif
+
+MapsReader::MapsReader(ProcessId pid)
+{
+#ifdef Q_OS_LINUX
+    char pidName[32];
+    snprintf(pidName, sizeof(pidName), "%lu", static_cast<unsigned long>(pid));
+    open(pidName);
+#else
+    Q_UNUSED(pid);
+#endif
+}
+
+MapsReader::MapsReader(const char *pidName)
+{
+    open(pidName);
+}
+
+MapsReader::~MapsReader()
+{
+#ifdef Q_OS_LINUX
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+void MapsReader::open(const char *pidName)
+{
+#ifdef Q_OS_LINUX
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%s/maps", pidName);
+    fd = ::open(path, O_RDONLY | O_CLOEXEC);
+#else
+    Q_UNUSED(pidName);
+#endif
+}
+
+bool MapsReader::fill()
+{
+#ifdef Q_OS_LINUX
+    // 把不完整的最后一行移到缓冲区开头；整块都没有换行时丢弃该行
+    int remaining = filled - position;
+    if (remaining == int(sizeof(buffer))) {
+        remaining = 0;
+        skipping = true;
+    } else if (remaining > 0 && position > 0) {
+        memmove(buffer, buffer + position, size_t(remaining));
+    }
+    filled = remaining;
+    position = 0;
+
+    const ssize_t len = read(fd, buffer + filled, sizeof(buffer) - size_t(filled));
+    if (len <= 0) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    filled += int(len);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MapsReader::next(MapsEntry *entry)
+{
+#ifdef Q_OS_LINUX
+    while (true) {
+        const char *line = buffer + position;
+        const char *newline = static_cast<const char *>(
+            memchr(line, '\n', size_t(filled - position)));
+        if (!newline) {
+            if (fd < 0 || !fill()) {
+                return false;
+            }
+            continue;
+        }
+
+        position = int(newline + 1 - buffer);
+        if (skipping) {
+            skipping = false;
+            continue;
+        }
+        if (parseLine(line, newline, entry)) {
+            return true;
+        }
+    }
+#else
+    Q_UNUSED(entry);
+    return false;
+#endif
+}
+
+QVector<ProcessModule> MapsReader::readModules(ProcessId pid, bool *ok)
+{
+    QVector<ProcessModule> modules;
+    MapsReader reader(pid);
+    if (ok) {
+        *ok = reader.isOpen();
+    }
+
+    // 同一文件的各段通常相邻，先和上一条比较，不命中再查哈希表
+    QHash<FileId, int> moduleIndex;
+    FileId lastFile;
+    int lastIndex = -1;
+    MapsEntry entry;
+    while (reader.next(&entry)) {
+        if (!entry.isFileBacked()) {
+            continue;
+        }
+
+        int index = -1;
+        if (lastIndex >= 0 && entry.file == lastFile) {
+            index = lastIndex;
+        } else {
+            QHash<FileId, int>::const_iterator it = moduleIndex.constFind(entry.file);
+            if (it != moduleIndex.constEnd()) {
+                index = it.value();
+            }
+        }
+
+        if (index < 0) {
+            ProcessModule module;
+            module.path = QString::fromLocal8Bit(entry.path, entry.pathLength);
+            module.file = entry.file;
+            module.start = entry.start;
+            module.end = entry.end;
+            module.offset = entry.offset;
+            memcpy(module.perms, entry.perms, sizeof(module.perms));
+            index = modules.size();
+            modules.append(module);
+            moduleIndex.insert(entry.file, index);
+        }
+
+        ProcessModule &module = modules[index];
+        if (entry.start < module.start) {
+            module.start = entry.start;
+            module.offset = entry.offset;
+        }
+        if (entry.end > module.end) {
+            module.end = entry.end;
+        }
+        module.mappedSize += entry.size();
+        ++module.segmentCount;
+        for (int i = 0; i < 3; ++i) {
+            if (entry.perms[i] != '-') {
+                module.perms[i] = entry.perms[i];
+            }
+        }
+
+        lastFile = entry.file;
+        lastIndex = index;
+    }
+
+    return modules;
+}
@@ -0,0 +1,54 @@
+#ifndef MAPSREADER_H
+#define MAPSREADER_H
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "processtypes.h"
+
+// /proc/<pid>/maps 中的一条映射。path 指向读取器内部缓冲区，只在下一次 next() 之前有效
+struct MapsEntry {
+    quint64 start = 0;
+    quint64 end = 0;
+    quint64 offset = 0;
+    FileId file;             // inode 为 0 表示匿名映射
+    char perms[5] = {};      // 如 "r-xp"
+    const char *path = nullptr;
+    int pathLength = 0;
+
+    quint64 size() const { return end - start; }
+    bool isFileBacked() const { return file.inode != 0; }
+};
+
+// /proc/<pid>/maps 流式解析器：数据分块读入对象内的固定缓冲区，用 memchr 切分行，
+// 各字段原地解析为数字，不构造 QString 也不产生堆分配。
+// 单行超过缓冲区大小（极长路径）时跳过该行。仅支持 Linux。
+class MapsReader
+{
+public:
+    explicit MapsReader(ProcessId pid);
+    explicit MapsReader(const char *pidName);
+    ~MapsReader();
+
+    bool isOpen() const { return fd >= 0; }
+
+    // 取下一条映射，读完或出错时返回 false
+    bool next(MapsEntry *entry);
+
+    // 读取进程映射的所有文件，按 (设备号, inode) 去重并合并同一文件的各个段
+    static QVector<ProcessModule> readModules(ProcessId pid, bool *ok = nullptr);
+
+private:
+    Q_DISABLE_COPY(MapsReader)
+
+    void open(const char *pidName);
+    bool fill();
+
+    int fd = -1;
+    int filled = 0;       // 缓冲区中的有效字节数
+    int position = 0;     // 下一行的起始位置
+    bool skipping = false;  // 正在跳过一条超长的行
+    char buffer[16384];
+};
+
+#endif // MAPSREADER_H
@@ -0,0 +1,180 @@
+#include "parallelscan.h"
+#include "procenumerator.h"
+
+#include <QFuture>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <atomic>
+#include <vector>
+
+namespace {
+QAtomicInt configuredThreads(0);
+
+// 每个工作线程的待处理区间 [begin, end)，打包在一个 64 位原子量中，
+// 自取和窃取都通过一次 CAS 完成；填充到整条缓存行，避免线程间伪共享
+struct WorkRange {
+    std::atomic<quint64> range;
+    char padding[64 - sizeof(std::atomic<quint64>)];
+
+    WorkRange() : range(0) {}
+};
+
+inline quint64 packRange(quint32 begin, quint32 end)
+{
+    return (quint64(begin) << 32) | end;
+}
+
+struct SharedState {
+    const QVector<ProcessId> *pids;
+    const QAtomicInt *cancelFlag;
+    const ParallelScan::Work *work;
+    std::vector<WorkRange> ranges;
+    std::atomic<bool> canceled;
+
+    explicit SharedState(int workers) : ranges(size_t(workers)), canceled(false) {}
+
+    // 从自己区间的头部取一个任务
+    bool takeOwn(int self, quint32 *index)
+    {
+        std::atomic<quint64> &slot = ranges[size_t(self)].range;
+        quint64 current = slot.load(std::memory_order_acquire);
+        while (true) {
+            const quint32 begin = quint32(current >> 32);
+            const quint32 end = quint32(current);
+            if (begin >= end) {
+                return false;
+            }
+            if (slot.compare_exchange_weak(current, packRange(begin + 1, end),
+                                           std::memory_order_acq_rel)) {
+                *index = begin;
+                return true;
+            }
+        }
+    }
+
+    // 从其他线程区间的尾部窃取一半放入自己的区间；所有区间都为空时返回 false
+    bool steal(int self)
+    {
+        const int workers = int(ranges.size());
+        for (int step = 1; step < workers; ++step) {
+            std::atomic<quint64> &victim = ranges[size_t((self + step) % workers)].range;
+            quint64 current = victim.load(std::memory_order_acquire);
+            while (true) {
+                const quint32 begin = quint32(current >> 32);
+                const quint32 end = quint32(current);
+                if (begin >= end) {
+                    break;
+                }
+                const quint32 middle = begin + (end - begin) / 2;
+                if (victim.compare_exchange_weak(current, packRange(begin, middle),
+                                                 std::memory_order_acq_rel)) {
+                    ranges[size_t(self)].range.store(packRange(middle, end),
+                                                     std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void runWorker(int self)
+    {
+        quint32 index = 0;
+        while (true) {
+            if (!takeOwn(self, &index)) {
+                if (!steal(self)) {
+                    return;
+                }
+                continue;
+            }
+            if (canceled.load(std::memory_order_relaxed) ||
+                (cancelFlag && cancelFlag->loadAcquire())) {
+                canceled.store(true, std::memory_order_relaxed);
+                return;
+            }
+            (*work)(self, pids->at(int(index)));
+        }
+    }
+};
+
+// 专用线程池，避免与全局线程池中的查询任务互相占用线程
+QThreadPool *scanPool()
+{
+    static QThreadPool pool;
+    return &pool;
+}
+}
+
+void ParallelScan::setDefaultThreadCount(int count)
+{
+    configuredThreads.storeRelease(qMax(0, count));
+}
+
+int ParallelScan::defaultThreadCount()
+{
+    const int configured = configuredThreads.loadAcquire();
+    return configured > 0 ? configured : qMax(1, QThread::idealThreadCount());
+}
+
+int ParallelScan::resolveThreadCount(int threadCount, int taskCount)
+{
+    const int wanted = threadCount > 0 ? threadCount : defaultThreadCount();
+    return qMax(1, qMin(wanted, taskCount));
+}
+
+QVector<ProcessId> ParallelScan::listProcesses()
+{
+    QVector<ProcessId> pids;
+    ProcEnumerator processes;
+    ProcessId pid = 0;
+    while (processes.next(&pid)) {
+        pids.append(pid);
+    }
+    return pids;
+}
+
+bool ParallelScan::run(const QVector<ProcessId> &pids, int threadCount,
+                       const QAtomicInt *cancelFlag, const Work &work)
+{
+    if (pids.isEmpty()) {
+        return !(cancelFlag && cancelFlag->loadAcquire());
+    }
+
+    const int workers = resolveThreadCount(threadCount, pids.size());
+    SharedState state(workers);
+    state.pids = &pids;
+    state.cancelFlag = cancelFlag;
+    state.work = &work;
+
+    // 初始均分
+    const quint32 total = quint32(pids.size());
+    for (int i = 0; i < workers; ++i) {
+        const quint32 begin = quint32(quint64(total) * quint64(i) / quint64(workers));
+        const quint32 end = quint32(quint64(total) * quint64(i + 1) / quint64(workers));
+        state.ranges[size_t(i)].range.store(packRange(begin, end), std::memory_order_relaxed);
+    }
+
+    QThreadPool *pool = scanPool();
+    if (pool->maxThreadCount() < workers - 1) {
+        pool->setMaxThreadCount(workers - 1);
+    }
+
+    QVector<QFuture<void>> futures;
+    futures.reserve(workers - 1);
+    SharedState *shared = &state;
+    for (int i = 1; i < workers; ++i) {
+        futures.append(QtConcurrent::run(pool, [shared, i]() {
+            shared->runWorker(i);
+        }));
+    }
+
+    // 线程池繁忙时其余线程可能尚未启动，调用线程会把全部区间窃取过来自己完成
+    state.runWorker(0);
+    for (QFuture<void> &future : futures) {
+        future.waitForFinished();
+    }
+
+    return !state.canceled.load();
+}
@@ -0,0 +1,35 @@
+#ifndef PARALLELSCAN_H
+#define PARALLELSCAN_H
+
+#include <QAtomicInt>
+#include <QVector>
+
+#include <functional>
+
+#include "processtypes.h"
+
+// 按 PID 并行执行的工作窃取调度器。
+// PID 列表先均分给各工作线程，线程处理完自己的区间后从其他线程区间的尾部窃取一半继续处理，
+// 直到所有区间为空；单个进程耗时差异很大（fd 数从几个到几十万）时各线程也能同时结束。
+// 调用线程本身作为 0 号工作线程参与，其余线程来自专用线程池。
+// 回调带有工作线程下标，调用方按下标为每个线程准备独立的结果缓冲区，结束后合并，全程无需加锁。
+class ParallelScan
+{
+public:
+    typedef std::function<void(int worker, ProcessId pid)> Work;
+
+    // 默认线程数，0 表示按 CPU 核数自动选择；可在任意线程调用
+    static void setDefaultThreadCount(int count);
+    static int defaultThreadCount();
+    // threadCount 不大于 0 时取默认值，并限制在 [1, 任务数] 范围内
+    static int resolveThreadCount(int threadCount, int taskCount);
+
+    // 枚举 /proc 中的全部 PID
+    static QVector<ProcessId> listProcesses();
+
+    // 对每个 PID 调用 work，返回前所有回调均已结束；被取消时返回 false
+    static bool run(const QVector<ProcessId> &pids, int threadCount,
+                    const QAtomicInt *cancelFlag, const Work &work);
+};
+
+#endif // PARALLELSCAN_H
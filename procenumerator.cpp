@@ -0,0 +1,191 @@
+#include "procenumerator.h"
+
+#ifdef Q_OS_LINUX
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+// getdents64 返回的目录项布局（内核 linux_dirent64）
+struct LinuxDirent64 {
+    quint64 inode;
+    qint64 offset;
+    unsigned short recordLength;
+    unsigned char type;
+    char name[1];
+};
+}
+#endif
+
+namespace {
+inline char foldAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+}
+}
+
+ProcEnumerator::ProcEnumerator()
+{
+#ifdef Q_OS_LINUX
+    procFd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+}
+
+ProcEnumerator::~ProcEnumerator()
+{
+#ifdef Q_OS_LINUX
+    if (procFd >= 0) {
+        close(procFd);
+    }
+#endif
+}
+
+bool ProcEnumerator::fill()
+{
+#ifdef Q_OS_LINUX
+    const long len = syscall(SYS_getdents64, procFd, buffer, sizeof(buffer));
+    if (len <= 0) {
+        finished = true;
+        return false;
+    }
+    bufferLength = int(len);
+    bufferOffset = 0;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ProcEnumerator::next(ProcessId *pid)
+{
+#ifdef Q_OS_LINUX
+    if (procFd < 0) {
+        return false;
+    }
+
+    while (!finished) {
+        if (bufferOffset >= bufferLength && !fill()) {
+            return false;
+        }
+
+        const LinuxDirent64 *entry = reinterpret_cast<const LinuxDirent64 *>(buffer + bufferOffset);
+        bufferOffset += entry->recordLength;
+
+        if (entry->type != DT_DIR && entry->type != DT_UNKNOWN) {
+            continue;
+        }
+
+        // 只接受纯数字目录名，直接在字节上解析
+        const char *name = entry->name;
+        if (*name < '1' || *name > '9') {
+            continue;
+        }
+        ProcessId value = 0;
+        for (; *name >= '0' && *name <= '9'; ++name) {
+            value = value * 10 + ProcessId(*name - '0');
+        }
+        if (*name != '\0') {
+            continue;
+        }
+
+        *pid = value;
+        return true;
+    }
+    return false;
+#else
+    Q_UNUSED(pid);
+    return false;
+#endif
+}
+
+void ProcEnumerator::rewind()
+{
+#ifdef Q_OS_LINUX
+    if (procFd >= 0) {
+        lseek(procFd, 0, SEEK_SET);
+    }
+#endif
+    bufferLength = 0;
+    bufferOffset = 0;
+    finished = false;
+}
+
+int ProcEnumerator::readFile(ProcessId pid, const char *name, char *target, int size) const
+{
+#ifdef Q_OS_LINUX
+    if (procFd < 0 || size <= 0) {
+        return -1;
+    }
+
+    // 相对 /proc 的目录描述符打开，内核无需再解析 "/proc" 前缀
+    char path[64];
+    snprintf(path, sizeof(path), "%lu/%s", static_cast<unsigned long>(pid), name);
+    const int fd = openat(procFd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    const ssize_t len = pread(fd, target, size_t(size), 0);
+    close(fd);
+    return int(len);
+#else
+    Q_UNUSED(pid);
+    Q_UNUSED(name);
+    Q_UNUSED(target);
+    Q_UNUSED(size);
+    return -1;
+#endif
+}
+
+int ProcEnumerator::readComm(ProcessId pid, char *target, int size) const
+{
+    int len = readFile(pid, "comm", target, size);
+    while (len > 0 && (target[len - 1] == '\n' || target[len - 1] == '\0')) {
+        --len;
+    }
+    return len;
+}
+
+bool ProcEnumerator::ownerUid(ProcessId pid, uint *uid) const
+{
+#ifdef Q_OS_LINUX
+    if (procFd < 0) {
+        return false;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "%lu", static_cast<unsigned long>(pid));
+    struct stat st;
+    if (fstatat(procFd, name, &st, 0) != 0) {
+        return false;
+    }
+    *uid = uint(st.st_uid);
+    return true;
+#else
+    Q_UNUSED(pid);
+    Q_UNUSED(uid);
+    return false;
+#endif
+}
+
+bool ProcEnumerator::containsIgnoreCase(const char *text, int length, const QByteArray &needle)
+{
+    const int needleLength = needle.size();
+    if (needleLength == 0) {
+        return true;
+    }
+
+    const char *pattern = needle.constData();
+    for (int start = 0; start + needleLength <= length; ++start) {
+        int i = 0;
+        while (i < needleLength && foldAscii(text[start + i]) == foldAscii(pattern[i])) {
+            ++i;
+        }
+        if (i == needleLength) {
+            return true;
+        }
+    }
+    return false;
+}
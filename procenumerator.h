@@ -0,0 +1,47 @@
+#ifndef PROCENUMERATOR_H
+#define PROCENUMERATOR_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+#include "processtypes.h"
+
+// 低开销的 /proc 进程枚举器：用 getdents64 直接读取目录项，用 openat/pread 读取进程文件，
+// 全部使用对象内或调用方提供的固定缓冲区。枚举 PID、读取 comm 和按名称匹配的过程中
+// 不构造 QString，也不产生堆分配，只有匹配成功的进程才需要转换为 Qt 类型。仅支持 Linux。
+class ProcEnumerator
+{
+public:
+    ProcEnumerator();
+    ~ProcEnumerator();
+
+    bool isValid() const { return procFd >= 0; }
+
+    // 取下一个 PID，枚举结束时返回 false
+    bool next(ProcessId *pid);
+    // 从头重新枚举
+    void rewind();
+
+    // 读取 /proc/<pid>/<name> 的前 size 字节，返回读取长度，失败时返回 -1
+    int readFile(ProcessId pid, const char *name, char *buffer, int size) const;
+    // 读取进程名（/proc/<pid>/comm），去掉结尾换行
+    int readComm(ProcessId pid, char *buffer, int size) const;
+    // 取进程所属用户（/proc/<pid> 目录的属主，即有效 UID），只需一次 fstatat，不读取文件
+    bool ownerUid(ProcessId pid, uint *uid) const;
+
+    // 按字节判断 text 是否包含 needle，ASCII 字母不区分大小写
+    static bool containsIgnoreCase(const char *text, int length, const QByteArray &needle);
+
+private:
+    Q_DISABLE_COPY(ProcEnumerator)
+
+    bool fill();
+
+    int procFd = -1;
+    int bufferLength = 0;
+    int bufferOffset = 0;
+    bool finished = false;
+    char buffer[32768];  // getdents64 目录项缓冲区，一次系统调用可取回约一千个进程
+};
+
+#endif // PROCENUMERATOR_H
@@ -0,0 +1,303 @@
+#include "processfilter.h"
+#include "procenumerator.h"
+
+#include <QStringList>
+
+#include <string.h>
+
+#ifdef Q_OS_LINUX
+#include <pwd.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// 按空白切分，双引号内的空白保留，引号本身去掉
+QStringList splitTokens(const QString &text, bool *balanced)
+{
+    QStringList tokens;
+    QString current;
+    bool quoted = false;
+    bool hasToken = false;
+    for (const QChar c : text) {
+        if (c == QChar('"')) {
+            quoted = !quoted;
+            hasToken = true;
+        } else if (c.isSpace() && !quoted) {
+            if (hasToken) {
+                tokens.append(current);
+                current.clear();
+                hasToken = false;
+            }
+        } else {
+            current.append(c);
+            hasToken = true;
+        }
+    }
+    if (hasToken) {
+        tokens.append(current);
+    }
+    *balanced = !quoted;
+    return tokens;
+}
+
+bool parsePid(const QString &text, ProcessId *pid)
+{
+    bool ok = false;
+    const ProcessId value = ProcessId(text.toULong(&ok));
+    if (!ok || value == 0) {
+        return false;
+    }
+    *pid = value;
+    return true;
+}
+
+bool isDigits(const QString &text)
+{
+    for (const QChar c : text) {
+        if (!c.isDigit()) {
+            return false;
+        }
+    }
+    return !text.isEmpty();
+}
+
+bool lookupUser(const QString &name, uint *uid)
+{
+#ifdef Q_OS_LINUX
+    long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+    if (size <= 0) {
+        size = 16384;
+    }
+    QByteArray buffer(int(size), Qt::Uninitialized);
+    struct passwd entry;
+    struct passwd *result = nullptr;
+    const QByteArray user = name.toLocal8Bit();
+    if (getpwnam_r(user.constData(), &entry, buffer.data(), size_t(buffer.size()), &result) != 0 ||
+        !result) {
+        return false;
+    }
+    *uid = uint(result->pw_uid);
+    return true;
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(uid);
+    return false;
+#endif
+}
+}
+
+bool ProcessFilter::parse(const QString &text)
+{
+    *this = ProcessFilter();
+
+    bool balanced = true;
+    const QStringList tokens = splitTokens(text, &balanced);
+    if (!balanced) {
+        error = QString::fromUtf8("引号不匹配");
+        return false;
+    }
+    if (tokens.isEmpty()) {
+        error = QString::fromUtf8("过滤条件为空");
+        return false;
+    }
+
+    for (const QString &token : tokens) {
+        const int colon = token.indexOf(QChar(':'));
+        bool ok;
+        if (colon <= 0) {
+            // 不带前缀：纯数字按 PID，否则按进程名
+            ok = addCondition(isDigits(token) ? QString("pid") : QString("name"), token);
+        } else {
+            ok = addCondition(token.left(colon).toLower(), token.mid(colon + 1));
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProcessFilter::addCondition(const QString &key, const QString &value)
+{
+    if (value.isEmpty()) {
+        error = QString::fromUtf8("条件 %1 缺少取值").arg(key);
+        return false;
+    }
+
+    if (key == "pid") {
+        if (!parsePid(value, &targetPid)) {
+            error = QString::fromUtf8("无效的 PID：%1").arg(value);
+            return false;
+        }
+        pidSet = true;
+    } else if (key == "name") {
+        nameNeedle = value.toLocal8Bit();
+    } else if (key == "regex") {
+        nameRegex = QRegularExpression(value, QRegularExpression::CaseInsensitiveOption);
+        if (!nameRegex.isValid()) {
+            error = QString::fromUtf8("无效的正则表达式 %1：%2").arg(value, nameRegex.errorString());
+            return false;
+        }
+        nameRegex.optimize();
+        regexSet = true;
+    } else if (key == "cmd") {
+        commandNeedle = value.toLocal8Bit();
+    } else if (key == "user") {
+        if (isDigits(value)) {
+            uid = value.toUInt();
+        } else if (!lookupUser(value, &uid)) {
+            error = QString::fromUtf8("未知用户：%1").arg(value);
+            return false;
+        }
+        uidSet = true;
+    } else if (key == "ppid") {
+        if (!isDigits(value)) {
+            error = QString::fromUtf8("无效的父进程 PID：%1").arg(value);
+            return false;
+        }
+        parentPid = ProcessId(value.toULong());
+        parentSet = true;
+    } else if (key == "cgroup") {
+        cgroupPrefix = value.toLocal8Bit();
+    } else {
+        error = QString::fromUtf8("未知的过滤条件：%1\n可用条件：pid、name、regex、cmd、user、ppid、cgroup").arg(key);
+        return false;
+    }
+    return true;
+}
+
+// 解析 /proc/<pid>/stat 的前几个字段："pid (comm) state ppid ..."，comm 中可能含有括号和空格
+bool ProcessFilter::readStat(const ProcEnumerator &processes, Candidate *candidate,
+                             ProcessId *parent) const
+{
+    char stat[512];
+    const int len = processes.readFile(candidate->pid, "stat", stat, int(sizeof(stat)));
+    if (len <= 0) {
+        return false;
+    }
+
+    const char *open = static_cast<const char *>(memchr(stat, '(', size_t(len)));
+    const char *close = stat + len - 1;
+    while (close > stat && *close != ')') {
+        --close;
+    }
+    if (!open || close <= open) {
+        return false;
+    }
+
+    const int nameLength = qMin(int(close - open - 1), int(sizeof(candidate->name)));
+    memcpy(candidate->name, open + 1, size_t(nameLength));
+    candidate->nameLength = nameLength;
+
+    // ") S ppid"
+    const char *p = close + 1;
+    const char *end = stat + len;
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    while (p < end && *p != ' ') {
+        ++p;
+    }
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    ProcessId value = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        value = value * 10 + ProcessId(*p - '0');
+    }
+    *parent = value;
+    return true;
+}
+
+bool ProcessFilter::matches(const ProcEnumerator &processes, ProcessId pid,
+                            Candidate *candidate) const
+{
+    candidate->pid = pid;
+    candidate->nameLength = -1;
+
+    if (pidSet && pid != targetPid) {
+        return false;
+    }
+
+    // 1. UID：只需 fstatat，不打开任何文件
+    if (uidSet) {
+        uint owner = 0;
+        if (!processes.ownerUid(pid, &owner) || owner != uid) {
+            return false;
+        }
+    }
+
+    // 2. stat：一次读取同时得到进程名和父进程
+    if (parentSet || !nameNeedle.isEmpty() || regexSet) {
+        ProcessId parent = 0;
+        if (!readStat(processes, candidate, &parent)) {
+            return false;
+        }
+        if (parentSet && parent != parentPid) {
+            return false;
+        }
+        if (!nameNeedle.isEmpty() &&
+            !ProcEnumerator::containsIgnoreCase(candidate->name, candidate->nameLength, nameNeedle)) {
+            return false;
+        }
+        if (regexSet &&
+            !nameRegex.match(QString::fromLocal8Bit(candidate->name, candidate->nameLength)).hasMatch()) {
+            return false;
+        }
+    }
+
+    // 3. cmdline：参数以 '\0' 分隔，换成空格后按子串匹配，超长部分截断
+    if (!commandNeedle.isEmpty()) {
+        char commandLine[8192];
+        const int len = processes.readFile(pid, "cmdline", commandLine, int(sizeof(commandLine)));
+        if (len <= 0) {
+            return false;
+        }
+        for (int i = 0; i < len; ++i) {
+            if (commandLine[i] == '\0') {
+                commandLine[i] = ' ';
+            }
+        }
+        if (!ProcEnumerator::containsIgnoreCase(commandLine, len, commandNeedle)) {
+            return false;
+        }
+    }
+
+    // 4. cgroup：每行格式 "hierarchy-ID:controllers:path"，任一路径以前缀开头即可
+    if (!cgroupPrefix.isEmpty()) {
+        char cgroups[4096];
+        const int len = processes.readFile(pid, "cgroup", cgroups, int(sizeof(cgroups)));
+        if (len <= 0) {
+            return false;
+        }
+        bool found = false;
+        const char *line = cgroups;
+        const char *end = cgroups + len;
+        while (line < end && !found) {
+            const char *newline = static_cast<const char *>(memchr(line, '\n', size_t(end - line)));
+            const char *lineEnd = newline ? newline : end;
+            const char *colon = static_cast<const char *>(memchr(line, ':', size_t(lineEnd - line)));
+            if (colon) {
+                colon = static_cast<const char *>(memchr(colon + 1, ':', size_t(lineEnd - colon - 1)));
+            }
+            if (colon) {
+                const char *path = colon + 1;
+                found = lineEnd - path >= cgroupPrefix.size() &&
+                        memcmp(path, cgroupPrefix.constData(), size_t(cgroupPrefix.size())) == 0;
+            }
+            line = lineEnd + 1;
+        }
+        if (!found) {
+            return false;
+        }
+    }
+
+    // 全部条件通过后才读取尚未取得的进程名
+    if (candidate->nameLength < 0) {
+        candidate->nameLength = processes.readComm(pid, candidate->name, int(sizeof(candidate->name)));
+        if (candidate->nameLength < 0) {
+            return false;
+        }
+    }
+    return true;
+}
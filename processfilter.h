@@ -0,0 +1,61 @@
+#ifndef PROCESSFILTER_H
+#define PROCESSFILTER_H
+
+#include <QByteArray>
+#include <QRegularExpression>
+#include <QString>
+
+#include "processtypes.h"
+
+class ProcEnumerator;
+
+// 进程查询的过滤表达式。以空格分隔多个条件，全部满足才算匹配，取值含空格时用双引号括起：
+//   1234 或 pid:1234      PID
+//   java 或 name:java     进程名包含（不区分大小写）
+//   regex:^java$          进程名正则（不区分大小写）
+//   cmd:"-jar app"        命令行包含（不区分大小写）
+//   user:alice            所属用户，用户名或 UID
+//   ppid:1                父进程 PID
+//   cgroup:/system.slice  cgroup 路径前缀
+// 条件按读取代价从低到高求值：UID（对 /proc/<pid> 做一次 fstatat）→ /proc/<pid>/stat
+// （进程名、父进程）→ cmdline → cgroup，任一条件不满足立即返回，后面的文件不再读取。
+// 求值仅支持 Linux。
+class ProcessFilter
+{
+public:
+    // 匹配过程中读取到的进程信息，匹配成功后 name 一定有效
+    struct Candidate {
+        ProcessId pid = 0;
+        char name[64];
+        int nameLength = -1;
+    };
+
+    // 解析表达式，失败时返回 false，原因见 errorString()
+    bool parse(const QString &text);
+    QString errorString() const { return error; }
+
+    // 含 PID 条件时只需检查这一个进程，不必遍历 /proc
+    bool hasPid() const { return pidSet; }
+    ProcessId pid() const { return targetPid; }
+
+    bool matches(const ProcEnumerator &processes, ProcessId pid, Candidate *candidate) const;
+
+private:
+    bool addCondition(const QString &key, const QString &value);
+    bool readStat(const ProcEnumerator &processes, Candidate *candidate, ProcessId *parent) const;
+
+    bool pidSet = false;
+    ProcessId targetPid = 0;
+    bool uidSet = false;
+    uint uid = 0;
+    bool parentSet = false;
+    ProcessId parentPid = 0;
+    QByteArray nameNeedle;
+    bool regexSet = false;
+    QRegularExpression nameRegex;
+    QByteArray commandNeedle;
+    QByteArray cgroupPrefix;
+    QString error;
+};
+
+#endif // PROCESSFILTER_H
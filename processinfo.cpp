@@ -0,0 +1,184 @@
+#include "processinfo.h"
+
+#include <QMutexLocker>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// 超过这么多轮扫描未出现的进程从缓存中移除
+const quint64 kEvictAfterScans = 8;
+
+#ifdef Q_OS_LINUX
+// 读取 /proc 下的小文件到 buffer，返回读取的字节数
+ssize_t readProcFile(ProcessId pid, const char *name, char *buffer, size_t size)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%lu/%s", static_cast<unsigned long>(pid), name);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t len = read(fd, buffer, size);
+    close(fd);
+    return len;
+}
+#endif
+}
+
+ProcessInfoCache &ProcessInfoCache::shared()
+{
+    static ProcessInfoCache cache;
+    return cache;
+}
+
+void ProcessInfoCache::beginScan()
+{
+    QMutexLocker locker(&mutex);
+    ++generation;
+
+    QHash<ProcessId, Entry>::iterator it = entries.begin();
+    while (it != entries.end()) {
+        if (generation - it->checkedGeneration > kEvictAfterScans) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+ProcessInfo ProcessInfoCache::lookup(ProcessId pid, int wantedFields)
+{
+    quint64 currentGeneration;
+    ProcessInfo cached;
+    bool checked = false;
+    {
+        QMutexLocker locker(&mutex);
+        currentGeneration = generation;
+        QHash<ProcessId, Entry>::const_iterator it = entries.constFind(pid);
+        if (it != entries.constEnd()) {
+            cached = it->info;
+            checked = it->checkedGeneration == currentGeneration;
+        }
+        if (checked && (cached.fields & wantedFields) == wantedFields) {
+            return cached;
+        }
+    }
+
+    // 文件读取在锁外进行，避免多个扫描线程互相等待
+    if (!checked) {
+        const quint64 startTime = readStartTime(pid);
+        if (startTime == 0 || startTime != cached.startTime) {
+            // 新进程或 PID 已被复用，之前读取的字段全部作废
+            cached = ProcessInfo();
+            cached.pid = pid;
+            cached.startTime = startTime;
+        }
+    }
+    readFields(cached, wantedFields & ~cached.fields);
+
+    QMutexLocker locker(&mutex);
+    Entry &entry = entries[pid];
+    if (entry.info.startTime == cached.startTime) {
+        // 其他线程可能同时补充了别的字段，合并而不是覆盖
+        const int missing = entry.info.fields & ~cached.fields;
+        if (missing & ProcessInfo::Name) {
+            cached.name = entry.info.name;
+        }
+        if (missing & ProcessInfo::ExePath) {
+            cached.exePath = entry.info.exePath;
+        }
+        if (missing & ProcessInfo::CommandLine) {
+            cached.commandLine = entry.info.commandLine;
+        }
+        if (missing & ProcessInfo::Uid) {
+            cached.uid = entry.info.uid;
+        }
+        cached.fields |= missing;
+    }
+    entry.info = cached;
+    entry.checkedGeneration = currentGeneration;
+    return cached;
+}
+
+void ProcessInfoCache::readFields(ProcessInfo &info, int wanted)
+{
+#ifdef Q_OS_LINUX
+    if (info.startTime == 0) {
+        // 进程已不存在，字段保持为空，但标记为已读取
+        info.fields |= wanted;
+        return;
+    }
+
+    char buffer[4096];
+
+    if (wanted & ProcessInfo::Name) {
+        ssize_t len = readProcFile(info.pid, "comm", buffer, sizeof(buffer));
+        while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\0')) {
+            --len;
+        }
+        info.name = len > 0 ? QString::fromLocal8Bit(buffer, int(len)) : QString();
+    }
+
+    if (wanted & ProcessInfo::ExePath) {
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/%lu/exe", static_cast<unsigned long>(info.pid));
+        const ssize_t len = readlink(path, buffer, sizeof(buffer));
+        info.exePath = len > 0 ? QString::fromLocal8Bit(buffer, int(len)) : QString();
+    }
+
+    if (wanted & ProcessInfo::CommandLine) {
+        // 过长的命令行只保留前 4KB
+        ssize_t len = readProcFile(info.pid, "cmdline", buffer, sizeof(buffer));
+        while (len > 0 && buffer[len - 1] == '\0') {
+            --len;
+        }
+        for (ssize_t i = 0; i < len; ++i) {
+            if (buffer[i] == '\0') {
+                buffer[i] = ' ';
+            }
+        }
+        info.commandLine = len > 0 ? QString::fromLocal8Bit(buffer, int(len)) : QString();
+    }
+
+    if (wanted & ProcessInfo::Uid) {
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/%lu", static_cast<unsigned long>(info.pid));
+        struct stat st;
+        info.uid = stat(path, &st) == 0 ? uint(st.st_uid) : 0;
+    }
+#endif
+    info.fields |= wanted;
+}
+
+quint64 ProcessInfoCache::readStartTime(ProcessId pid)
+{
+#ifdef Q_OS_LINUX
+    char buffer[1024];
+    const ssize_t len = readProcFile(pid, "stat", buffer, sizeof(buffer) - 1);
+    if (len <= 0) {
+        return 0;
+    }
+    buffer[len] = '\0';
+
+    // comm 字段可能包含空格和括号，从最后一个 ')' 之后开始数字段
+    const char *cursor = strrchr(buffer, ')');
+    if (!cursor) {
+        return 0;
+    }
+    for (int field = 2; field < 22 && cursor; ++field) {
+        cursor = strchr(cursor + 1, ' ');
+    }
+    return cursor ? strtoull(cursor + 1, nullptr, 10) : 0;
+#else
+    Q_UNUSED(pid);
+    return 0;
+#endif
+}
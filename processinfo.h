@@ -0,0 +1,62 @@
+#ifndef PROCESSINFO_H
+#define PROCESSINFO_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include "processtypes.h"
+
+// 进程元数据：各字段按需读取，fields 记录已读取的字段
+struct ProcessInfo {
+    enum Field {
+        Name = 0x1,         // /proc/<pid>/comm
+        ExePath = 0x2,      // /proc/<pid>/exe 链接目标
+        CommandLine = 0x4,  // /proc/<pid>/cmdline，参数以空格连接
+        Uid = 0x8           // /proc/<pid> 目录属主
+    };
+
+    ProcessId pid = 0;
+    quint64 startTime = 0;
+    int fields = 0;
+    QString name;
+    QString exePath;
+    QString commandLine;
+    uint uid = 0;
+};
+
+// 进程元数据缓存，按 (pid, 启动时间) 识别进程，PID 被复用时自动丢弃旧数据。
+// 同一个进程的 comm/exe/cmdline/uid 每项最多读取一次；
+// 每轮扫描开始时调用 beginScan()，同一轮内对同一 PID 只校验一次启动时间。
+// 可在多个工作线程中同时使用。目前仅在 Linux 上读取数据。
+class ProcessInfoCache
+{
+public:
+    static ProcessInfoCache &shared();
+
+    // 开始新一轮扫描：之后每个 PID 的首次查询会重新校验启动时间，并清理长期未出现的进程
+    void beginScan();
+
+    // 返回进程信息，保证 wantedFields 中的字段已读取（进程不存在时字段为空）
+    ProcessInfo lookup(ProcessId pid, int wantedFields);
+
+    QString name(ProcessId pid) { return lookup(pid, ProcessInfo::Name).name; }
+    QString exePath(ProcessId pid) { return lookup(pid, ProcessInfo::ExePath).exePath; }
+
+    // 读取 /proc/<pid>/stat 第 22 个字段（进程启动时间），进程不存在时返回 0
+    static quint64 readStartTime(ProcessId pid);
+
+private:
+    struct Entry {
+        ProcessInfo info;
+        quint64 checkedGeneration = 0;
+    };
+
+    static void readFields(ProcessInfo &info, int wanted);
+
+    QMutex mutex;
+    QHash<ProcessId, Entry> entries;
+    quint64 generation = 1;
+};
+
+#endif // PROCESSINFO_H
@@ -0,0 +1,300 @@
+#include "processkiller.h"
+#include "procenumerator.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+
+#ifdef Q_OS_WIN
+#include <tlhelp32.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+#endif
+
+namespace {
+// SIGKILL 之后等待进程退出的时间
+const int kKillWaitMs = 1000;
+
+#ifdef Q_OS_LINUX
+// 读取父进程 PID："pid (comm) state ppid ..."，comm 中可能含有括号
+bool readParent(const ProcEnumerator &processes, ProcessId pid, ProcessId *parent)
+{
+    char stat[512];
+    const int len = processes.readFile(pid, "stat", stat, int(sizeof(stat)));
+    if (len <= 0) {
+        return false;
+    }
+    const char *p = stat + len - 1;
+    while (p > stat && *p != ')') {
+        --p;
+    }
+    const char *end = stat + len;
+    p += 2;  // ") "
+    while (p < end && *p != ' ') {
+        ++p;
+    }
+    ProcessId value = 0;
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+        value = value * 10 + ProcessId(*p - '0');
+    }
+    *parent = value;
+    return true;
+}
+
+struct Victim {
+    ProcessId pid = 0;
+    int pidfd = -1;     // -1 表示不支持 pidfd，按 PID 操作
+    bool alive = true;
+    bool killed = false;
+    ProcessKiller::Outcome outcome = ProcessKiller::AlreadyExited;
+};
+
+int sendSignal(const Victim &victim, int signal)
+{
+    const long result = victim.pidfd >= 0
+        ? syscall(SYS_pidfd_send_signal, victim.pidfd, signal, nullptr, 0)
+        : long(kill(pid_t(victim.pid), signal));
+    return result == 0 ? 0 : errno;
+}
+
+// 等待进程退出直到截止时间；epoll 不可用的目标每 20ms 轮询一次
+void waitForExit(QVector<Victim> &victims, int epollFd, qint64 deadlineMs, const QElapsedTimer &clock)
+{
+    while (true) {
+        int pending = 0;
+        bool polling = false;
+        for (Victim &victim : victims) {
+            if (!victim.alive) {
+                continue;
+            }
+            if (victim.pidfd < 0) {
+                if (kill(pid_t(victim.pid), 0) != 0 && errno == ESRCH) {
+                    victim.alive = false;
+                    continue;
+                }
+                polling = true;
+            }
+            ++pending;
+        }
+        const qint64 remaining = deadlineMs - clock.elapsed();
+        if (pending == 0 || remaining <= 0) {
+            return;
+        }
+
+        const int timeout = polling ? int(qMin<qint64>(remaining, 20)) : int(remaining);
+        if (epollFd < 0) {
+            usleep(useconds_t(timeout) * 1000);
+            continue;
+        }
+        struct epoll_event events[64];
+        const int count = epoll_wait(epollFd, events, 64, timeout);
+        for (int i = 0; i < count; ++i) {
+            Victim &victim = victims[int(events[i].data.u32)];
+            victim.alive = false;
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, victim.pidfd, nullptr);
+        }
+    }
+}
+#endif
+}
+
+QVector<ProcessId> ProcessKiller::withDescendants(const QVector<ProcessId> &pids)
+{
+    QVector<ProcessId> result;
+    QSet<ProcessId> seen;
+    for (ProcessId pid : pids) {
+        if (!seen.contains(pid)) {
+            seen.insert(pid);
+            result.append(pid);
+        }
+    }
+
+    // 一次遍历建立 父进程 -> 子进程 表
+    QHash<ProcessId, QVector<ProcessId>> children;
+#ifdef Q_OS_WIN
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot != INVALID_HANDLE_VALUE) {
+        PROCESSENTRY32W entry;
+        entry.dwSize = sizeof(entry);
+        if (Process32FirstW(snapshot, &entry)) {
+            do {
+                if (entry.th32ProcessID != entry.th32ParentProcessID) {
+                    children[entry.th32ParentProcessID].append(entry.th32ProcessID);
+                }
+            } while (Process32NextW(snapshot, &entry));
+        }
+        CloseHandle(snapshot);
+    }
+#elif defined(Q_OS_LINUX)
+    ProcEnumerator processes;
+    ProcessId pid = 0;
+    while (processes.next(&pid)) {
+        ProcessId parent = 0;
+        if (readParent(processes, pid, &parent) && parent != 0) {
+            children[parent].append(pid);
+        }
+    }
+#endif
+
+    // 广度优先展开，父进程总在子进程之前
+    for (int i = 0; i < result.size(); ++i) {
+        const QVector<ProcessId> direct = children.value(result.at(i));
+        for (ProcessId child : direct) {
+            if (!seen.contains(child)) {
+                seen.insert(child);
+                result.append(child);
+            }
+        }
+    }
+    return result;
+}
+
+QVector<ProcessKiller::Result> ProcessKiller::terminate(const QVector<ProcessId> &pids, int graceMs)
+{
+    QVector<Result> results;
+    results.reserve(pids.size());
+
+#ifdef Q_OS_WIN
+    Q_UNUSED(graceMs);
+    const ProcessId self = GetCurrentProcessId();
+    for (ProcessId pid : pids) {
+        Result result;
+        result.pid = pid;
+        if (pid == self) {
+            result.outcome = Skipped;
+        } else if (HANDLE process = OpenProcess(PROCESS_TERMINATE, FALSE, pid)) {
+            result.outcome = TerminateProcess(process, 1) ? Killed : Denied;
+            CloseHandle(process);
+        } else {
+            result.outcome = GetLastError() == ERROR_ACCESS_DENIED ? Denied : AlreadyExited;
+        }
+        results.append(result);
+    }
+#elif defined(Q_OS_LINUX)
+    QElapsedTimer clock;
+    clock.start();
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    const ProcessId self = ProcessId(getpid());
+
+    // 1. 打开 pidfd 并发送 SIGTERM；此后 PID 被复用也不影响
+    QVector<Victim> victims;
+    victims.reserve(pids.size());
+    for (ProcessId pid : pids) {
+        Victim victim;
+        victim.pid = pid;
+        if (pid == self) {
+            victim.alive = false;
+            victim.outcome = Skipped;
+            victims.append(victim);
+            continue;
+        }
+
+        victim.pidfd = int(syscall(SYS_pidfd_open, pid_t(pid), 0));
+        if (victim.pidfd < 0 && errno == ESRCH) {
+            victim.alive = false;
+            victim.outcome = AlreadyExited;
+            victims.append(victim);
+            continue;
+        }
+        if (victim.pidfd >= 0 && epollFd < 0) {
+            // 无法等待 pidfd 时退回按 PID 轮询
+            close(victim.pidfd);
+            victim.pidfd = -1;
+        }
+
+        const int error = sendSignal(victim, SIGTERM);
+        if (error != 0) {
+            victim.alive = false;
+            victim.outcome = error == EPERM ? Denied : AlreadyExited;
+        } else {
+            victim.outcome = Terminated;
+            if (victim.pidfd >= 0) {
+                struct epoll_event event;
+                memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN;
+                event.data.u32 = quint32(victims.size());
+                epoll_ctl(epollFd, EPOLL_CTL_ADD, victim.pidfd, &event);
+            }
+        }
+        victims.append(victim);
+    }
+
+    // 2. 同时等待全部进程，直到宽限期结束
+    waitForExit(victims, epollFd, graceMs, clock);
+
+    // 3. 仍存活的进程发送 SIGKILL，再等待一小段时间
+    bool escalated = false;
+    for (Victim &victim : victims) {
+        if (victim.alive) {
+            victim.killed = sendSignal(victim, SIGKILL) == 0;
+            escalated = true;
+        }
+    }
+    if (escalated) {
+        waitForExit(victims, epollFd, clock.elapsed() + kKillWaitMs, clock);
+    }
+
+    for (Victim &victim : victims) {
+        Result result;
+        result.pid = victim.pid;
+        if (victim.alive) {
+            result.outcome = StillAlive;
+        } else if (victim.killed) {
+            result.outcome = Killed;
+        } else {
+            result.outcome = victim.outcome;
+        }
+        results.append(result);
+        if (victim.pidfd >= 0) {
+            close(victim.pidfd);
+        }
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+#else
+    Q_UNUSED(graceMs);
+    for (ProcessId pid : pids) {
+        Result result;
+        result.pid = pid;
+        result.outcome = Denied;
+        results.append(result);
+    }
+#endif
+
+    return results;
+}
+
+QString ProcessKiller::outcomeName(Outcome outcome)
+{
+    switch (outcome) {
+        case Terminated:
+            return QString::fromUtf8("已正常退出");
+        case Killed:
+            return QString::fromUtf8("已强制结束");
+        case AlreadyExited:
+            return QString::fromUtf8("进程已不存在");
+        case Denied:
+            return QString::fromUtf8("权限不足");
+        case StillAlive:
+            return QString::fromUtf8("仍未退出");
+        case Skipped:
+            return QString::fromUtf8("已跳过（本程序）");
+    }
+    return QString();
+}
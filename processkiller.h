@@ -0,0 +1,40 @@
+#ifndef PROCESSKILLER_H
+#define PROCESSKILLER_H
+
+#include <QString>
+#include <QVector>
+
+#include "processtypes.h"
+
+// 批量结束进程。
+// Linux 下先为每个目标打开 pidfd 固定进程身份，之后的信号和等待都通过 pidfd 进行，
+// 期间即使 PID 被回收复用也不会误杀其他进程；先发送 SIGTERM，用 epoll 同时等待全部 pidfd
+// 直到截止时间，仍存活的进程再发送 SIGKILL。内核不支持 pidfd（5.3 以前）时退回按 PID 发送信号并轮询。
+// Windows 下直接 TerminateProcess。
+class ProcessKiller
+{
+public:
+    enum Outcome {
+        Terminated,     // 收到 SIGTERM 后自行退出
+        Killed,         // 宽限期后被 SIGKILL 强制结束
+        AlreadyExited,  // 开始前进程已不存在
+        Denied,         // 权限不足
+        StillAlive,     // SIGKILL 后仍未退出（如处于不可中断睡眠）
+        Skipped         // 本程序自身
+    };
+
+    struct Result {
+        ProcessId pid = 0;
+        Outcome outcome = AlreadyExited;
+    };
+
+    // 在 pids 之后追加它们的全部子孙进程（去重，父进程在前）
+    static QVector<ProcessId> withDescendants(const QVector<ProcessId> &pids);
+
+    // 结束全部目标并等待其退出；graceMs 为 SIGTERM 后的宽限期
+    static QVector<Result> terminate(const QVector<ProcessId> &pids, int graceMs);
+
+    static QString outcomeName(Outcome outcome);
+};
+
+#endif // PROCESSKILLER_H
@@ -0,0 +1,53 @@
+#ifndef PROCESSTYPES_H
+#define PROCESSTYPES_H
+
+#include <QHash>
+#include <QString>
+#include <QtGlobal>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+typedef DWORD ProcessId;
+#else
+typedef unsigned long ProcessId;
+#endif
+
+// 文件身份标识：按 (st_dev, st_ino) 比较，而不是比较路径字符串，
+// 因此绑定挂载、符号链接、容器 overlay 路径以及重命名后的文件都能匹配。
+struct FileId {
+    quint64 device = 0;
+    quint64 inode = 0;
+
+    bool operator==(const FileId &other) const
+    {
+        return device == other.device && inode == other.inode;
+    }
+};
+
+inline uint qHash(const FileId &id, uint seed = 0)
+{
+    return qHash(id.inode ^ (id.device << 32) ^ (id.device >> 32), seed);
+}
+
+// 进程加载的一个模块。Linux 下按文件身份去重并合并该文件的所有映射段
+struct ProcessModule {
+    QString path;
+    FileId file;
+    quint64 start = 0;       // 最低映射地址
+    quint64 end = 0;         // 最高映射结束地址
+    quint64 offset = 0;      // 最低地址段的文件偏移
+    quint64 mappedSize = 0;  // 各映射段大小之和
+    int segmentCount = 0;
+    char perms[5] = {};      // 各段权限的并集，如 "r-xp"
+};
+
+// 句柄/进程查询结果表中的一行
+struct HandleRow {
+    QString processName;
+    ProcessId pid = 0;
+    QString path;
+    QString kind;  // 占用方式：fd、mem（内存映射）等，可为空
+    quint64 mappedSize = 0;  // 模块映射大小（字节），0 表示不适用
+};
+
+#endif // PROCESSTYPES_H
@@ -0,0 +1,157 @@
+#include "searchtask.h"
+
+#include <QMetaObject>
+#include <QtConcurrent>
+
+namespace {
+// 每批最多攒多少行、最长攒多久，兼顾首批结果延迟与 GUI 刷新开销
+const int kBatchRows = 512;
+const qint64 kBatchIntervalMs = 50;
+}
+
+SearchContext::SearchContext(SearchTask *owner, quint64 searchGeneration,
+                             const std::shared_ptr<QAtomicInt> &flag)
+    : task(owner)
+    , generation(searchGeneration)
+    , canceled(flag)
+{
+    sinceFlush.start();
+}
+
+void SearchContext::addRow(const HandleRow &row)
+{
+    pendingRows.append(row);
+    flushIfDue();
+}
+
+void SearchContext::addLine(const QString &line)
+{
+    pendingLines.append(line);
+    flushIfDue();
+}
+
+void SearchContext::clearText()
+{
+    pendingLines.clear();
+    SearchTask *owner = task;
+    const quint64 gen = generation;
+    QMetaObject::invokeMethod(owner, [owner, gen]() {
+        owner->deliverClear(gen);
+    }, Qt::QueuedConnection);
+}
+
+void SearchContext::flushIfDue()
+{
+    // 第一条结果立即投递，之后按数量或时间分批
+    if (!delivered || pendingRows.size() + pendingLines.size() >= kBatchRows ||
+        sinceFlush.elapsed() >= kBatchIntervalMs) {
+        flush();
+    }
+}
+
+void SearchContext::flush()
+{
+    SearchTask *owner = task;
+    const quint64 gen = generation;
+
+    if (!pendingRows.isEmpty()) {
+        QVector<HandleRow> rows;
+        rows.swap(pendingRows);
+        QMetaObject::invokeMethod(owner, [owner, gen, rows]() {
+            owner->deliverRows(gen, rows);
+        }, Qt::QueuedConnection);
+        delivered = true;
+    }
+
+    if (!pendingLines.isEmpty()) {
+        QStringList lines;
+        lines.swap(pendingLines);
+        QMetaObject::invokeMethod(owner, [owner, gen, lines]() {
+            owner->deliverLines(gen, lines);
+        }, Qt::QueuedConnection);
+        delivered = true;
+    }
+
+    sinceFlush.restart();
+}
+
+SearchTask::SearchTask(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SearchTask::~SearchTask()
+{
+    cancel();
+    // 工作线程持有本对象指针，必须等它们全部退出
+    for (QFuture<void> &future : futures) {
+        future.waitForFinished();
+    }
+}
+
+void SearchTask::start(const Job &job)
+{
+    cancel();
+
+    for (int i = futures.size() - 1; i >= 0; --i) {
+        if (futures.at(i).isFinished()) {
+            futures.remove(i);
+        }
+    }
+
+    const quint64 generation = ++currentGeneration;
+    std::shared_ptr<QAtomicInt> flag = std::make_shared<QAtomicInt>(0);
+    currentCancel = flag;
+    running = true;
+
+    SearchTask *owner = this;
+    futures.append(QtConcurrent::run([owner, generation, flag, job]() {
+        SearchContext context(owner, generation, flag);
+        job(context);
+        context.flush();
+
+        const SearchOutcome outcome = context.outcome();
+        QMetaObject::invokeMethod(owner, [owner, generation, outcome]() {
+            owner->deliverFinished(generation, outcome);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void SearchTask::cancel()
+{
+    if (currentCancel) {
+        currentCancel->storeRelease(1);
+        currentCancel.reset();
+    }
+    running = false;
+}
+
+void SearchTask::deliverRows(quint64 generation, const QVector<HandleRow> &rows)
+{
+    if (generation == currentGeneration && running) {
+        emit rowsReady(rows);
+    }
+}
+
+void SearchTask::deliverLines(quint64 generation, const QStringList &lines)
+{
+    if (generation == currentGeneration && running) {
+        emit linesReady(lines);
+    }
+}
+
+void SearchTask::deliverClear(quint64 generation)
+{
+    if (generation == currentGeneration && running) {
+        emit textCleared();
+    }
+}
+
+void SearchTask::deliverFinished(quint64 generation, const SearchOutcome &outcome)
+{
+    if (generation == currentGeneration && running) {
+        running = false;
+        currentCancel.reset();
+        emit finished(outcome);
+    }
+}
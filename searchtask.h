@@ -0,0 +1,103 @@
+#ifndef SEARCHTASK_H
+#define SEARCHTASK_H
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+#include "processtypes.h"
+
+class SearchTask;
+
+// 查询结束后在 GUI 线程展示的结果摘要
+struct SearchOutcome {
+    enum MessageLevel { NoMessage, Information, Warning, Critical };
+
+    int foundCount = 0;
+    QString status;       // 状态栏文本
+    MessageLevel level = NoMessage;
+    QString messageTitle;  // level 不为 NoMessage 时弹出提示框
+    QString messageText;
+
+    void setMessage(MessageLevel messageLevel, const QString &title, const QString &text)
+    {
+        level = messageLevel;
+        messageTitle = title;
+        messageText = text;
+    }
+};
+
+// 工作线程一侧的查询上下文：缓冲结果并分批投递回 GUI 线程
+class SearchContext
+{
+public:
+    bool isCanceled() const { return canceled->loadAcquire() != 0; }
+    const QAtomicInt *cancelFlag() const { return canceled.get(); }
+
+    void addRow(const HandleRow &row);
+    void addLine(const QString &line);
+    // 丢弃尚未投递的文本并清空输出框
+    void clearText();
+    void flush();
+
+    SearchOutcome &outcome() { return result; }
+
+private:
+    friend class SearchTask;
+    SearchContext(SearchTask *owner, quint64 searchGeneration,
+                  const std::shared_ptr<QAtomicInt> &flag);
+
+    void flushIfDue();
+
+    SearchTask *task;
+    quint64 generation;
+    std::shared_ptr<QAtomicInt> canceled;
+    QVector<HandleRow> pendingRows;
+    QStringList pendingLines;
+    QElapsedTimer sinceFlush;
+    bool delivered = false;
+    SearchOutcome result;
+};
+
+// 在线程池中执行查询，结果以批次形式通过信号送回 GUI 线程。
+// 新查询开始时会取消上一次查询，旧查询尚未送达的结果会被丢弃。
+class SearchTask : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void(SearchContext &)> Job;
+
+    explicit SearchTask(QObject *parent = nullptr);
+    ~SearchTask() override;
+
+    void start(const Job &job);
+    void cancel();
+    bool isRunning() const { return running; }
+
+signals:
+    void rowsReady(const QVector<HandleRow> &rows);
+    void linesReady(const QStringList &lines);
+    void textCleared();
+    void finished(const SearchOutcome &outcome);
+
+private:
+    friend class SearchContext;
+    void deliverRows(quint64 generation, const QVector<HandleRow> &rows);
+    void deliverLines(quint64 generation, const QStringList &lines);
+    void deliverClear(quint64 generation);
+    void deliverFinished(quint64 generation, const SearchOutcome &outcome);
+
+    quint64 currentGeneration = 0;
+    bool running = false;
+    std::shared_ptr<QAtomicInt> currentCancel;
+    QVector<QFuture<void>> futures;
+};
+
+#endif // SEARCHTASK_H
@@ -0,0 +1,637 @@
+#include "socketscanner.h"
+#include "processinfo.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QHostAddress>
+
+#include <string.h>
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <errno.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+const quint32 SocketScanner::kAllStates;
+
+namespace {
+const quint8 kTcpListen = 0x0A;
+const quint8 kUdpUnconnected = 0x07;  // UDP 未连接时内核报告为 TCP_CLOSE
+
+#ifdef Q_OS_LINUX
+bool isPidName(const char *name)
+{
+    if (*name < '1' || *name > '9') {
+        return false;
+    }
+    for (const char *p = name + 1; *p; ++p) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+// 解析十六进制数，遇到第一个非十六进制字符停止
+const char *parseHex(const char *p, quint64 *value)
+{
+    quint64 result = 0;
+    for (int digit = hexDigit(*p); digit >= 0; digit = hexDigit(*++p)) {
+        result = (result << 4) | quint64(digit);
+    }
+    *value = result;
+    return p;
+}
+
+const char *skipSpaces(const char *p)
+{
+    while (*p == ' ') {
+        ++p;
+    }
+    return p;
+}
+
+const char *skipField(const char *p)
+{
+    while (*p && *p != ' ' && *p != '\n') {
+        ++p;
+    }
+    return skipSpaces(p);
+}
+
+// 内核以 %08X 打印内存中的 32 位字，按本机字节序写回即得到网络字节序地址
+const char *parseAddress(const char *p, int words, quint8 *address, quint16 *port)
+{
+    for (int i = 0; i < words; ++i) {
+        quint32 word = 0;
+        for (int count = 0; count < 8; ++count, ++p) {
+            const int digit = hexDigit(*p);
+            if (digit < 0) {
+                break;
+            }
+            word = (word << 4) | quint32(digit);
+        }
+        memcpy(address + i * 4, &word, 4);
+    }
+    quint64 value = 0;
+    if (*p == ':') {
+        p = parseHex(p + 1, &value);
+    }
+    *port = quint16(value);
+    return skipSpaces(p);
+}
+
+// 逐行解析一个 /proc/net 套接字表，每个条目回调一次
+template <typename Callback>
+void parseSocketFile(const char *path, SocketEntry::Protocol protocol, quint32 stateMask,
+                     Callback onEntry)
+{
+    QFile file(QString::fromLatin1(path));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QByteArray data = file.readAll();
+    const int words = (protocol == SocketEntry::Tcp6 || protocol == SocketEntry::Udp6) ? 4 : 1;
+
+    // 格式: sl local_address rem_address st tx_queue:rx_queue tr:tm->when retrnsmt uid timeout inode ...
+    const char *line = data.constData();
+    const char *end = line + data.size();
+    line = static_cast<const char *>(memchr(line, '\n', size_t(end - line)));  // 跳过标题行
+    while (line && ++line < end) {
+        const char *next = static_cast<const char *>(memchr(line, '\n', size_t(end - line)));
+        const char *p = static_cast<const char *>(memchr(line, ':', size_t((next ? next : end) - line)));
+        if (!p) {
+            line = next;
+            continue;
+        }
+
+        SocketEntry entry;
+        entry.protocol = protocol;
+        p = parseAddress(skipSpaces(p + 1), words, entry.localAddress, &entry.localPort);
+        p = parseAddress(p, words, entry.remoteAddress, &entry.remotePort);
+
+        quint64 value = 0;
+        p = skipSpaces(parseHex(p, &value));
+        entry.state = quint8(value);
+        if (entry.state >= 32 || !(stateMask & (1u << entry.state))) {
+            line = next;
+            continue;
+        }
+        p = parseHex(p, &value);  // tx_queue:rx_queue
+        entry.sendQueue = quint32(value);
+        if (*p == ':') {
+            p = parseHex(p + 1, &value);
+            entry.receiveQueue = quint32(value);
+        }
+        p = skipSpaces(p);
+        p = skipField(p);  // tr:tm->when
+        p = skipField(p);  // retrnsmt
+        entry.uid = uint(strtoul(p, nullptr, 10));
+        p = skipField(p);
+        p = skipField(p);  // timeout
+        entry.inode = strtoull(p, nullptr, 10);
+
+        onEntry(entry);
+        line = next;
+    }
+}
+
+// 通过 NETLINK_SOCK_DIAG 导出一类套接字，状态过滤由内核完成。
+// 内核不支持该协议族（如未加载 udp_diag 模块）时返回 false，由调用方回退到 procfs。
+template <typename Callback>
+bool dumpNetlink(int family, int ipProtocol, SocketEntry::Protocol protocol, quint32 stateMask,
+                 Callback onEntry)
+{
+    const int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message;
+    memset(&message, 0, sizeof(message));
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = quint8(family);
+    message.request.sdiag_protocol = quint8(ipProtocol);
+    message.request.idiag_states = stateMask;
+
+    sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(fd, &message, sizeof(message), 0,
+               reinterpret_cast<sockaddr *>(&kernel), sizeof(kernel)) < 0) {
+        close(fd);
+        return false;
+    }
+
+    // 按 nlmsghdr 的对齐要求使用 32 位数组作为接收缓冲区
+    quint32 buffer[16384];
+    const int addressBytes = family == AF_INET6 ? 16 : 4;
+    bool delivered = false;
+    bool failed = false;
+    bool done = false;
+
+    while (!done) {
+        const ssize_t len = recv(fd, buffer, sizeof(buffer), 0);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed = true;
+            break;
+        }
+        if (len == 0) {
+            break;
+        }
+
+        int remaining = int(len);
+        for (const nlmsghdr *header = reinterpret_cast<const nlmsghdr *>(buffer);
+             NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE) {
+                done = true;
+                break;
+            }
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                failed = true;
+                done = true;
+                break;
+            }
+            if (header->nlmsg_type != SOCK_DIAG_BY_FAMILY) {
+                continue;
+            }
+
+            const inet_diag_msg *diag = static_cast<const inet_diag_msg *>(NLMSG_DATA(header));
+            SocketEntry entry;
+            entry.protocol = protocol;
+            memcpy(entry.localAddress, diag->id.idiag_src, size_t(addressBytes));
+            memcpy(entry.remoteAddress, diag->id.idiag_dst, size_t(addressBytes));
+            entry.localPort = ntohs(diag->id.idiag_sport);
+            entry.remotePort = ntohs(diag->id.idiag_dport);
+            entry.state = diag->idiag_state;
+            entry.sendQueue = diag->idiag_wqueue;
+            entry.receiveQueue = diag->idiag_rqueue;
+            entry.uid = diag->idiag_uid;
+            entry.inode = diag->idiag_inode;
+            onEntry(entry);
+            delivered = true;
+        }
+    }
+    close(fd);
+
+    // 已经送出部分结果时不再回退，避免重复
+    return !failed || delivered;
+}
+
+// 依次读取 TCP/TCP6/UDP/UDP6 套接字表，每一类优先使用 netlink
+template <typename Callback>
+SocketScanner::Backend forEachSocket(quint32 stateMask, Callback onEntry)
+{
+    struct Source {
+        int family;
+        int ipProtocol;
+        SocketEntry::Protocol protocol;
+        const char *procPath;
+    };
+    static const Source sources[] = {
+        { AF_INET, IPPROTO_TCP, SocketEntry::Tcp, "/proc/net/tcp" },
+        { AF_INET6, IPPROTO_TCP, SocketEntry::Tcp6, "/proc/net/tcp6" },
+        { AF_INET, IPPROTO_UDP, SocketEntry::Udp, "/proc/net/udp" },
+        { AF_INET6, IPPROTO_UDP, SocketEntry::Udp6, "/proc/net/udp6" }
+    };
+
+    int netlinkSources = 0;
+    for (const Source &source : sources) {
+        if (dumpNetlink(source.family, source.ipProtocol, source.protocol, stateMask, onEntry)) {
+            ++netlinkSources;
+        } else {
+            parseSocketFile(source.procPath, source.protocol, stateMask, onEntry);
+        }
+    }
+
+    const int sourceCount = int(sizeof(sources) / sizeof(sources[0]));
+    if (netlinkSources == sourceCount) {
+        return SocketScanner::Netlink;
+    }
+    return netlinkSources == 0 ? SocketScanner::Procfs : SocketScanner::Mixed;
+}
+
+// 读取一个 fd 链接，是套接字时返回其 inode，否则返回 0
+quint64 socketInode(const char *linkPath)
+{
+    static const char kSocketPrefix[] = "socket:[";
+    const size_t prefixLength = sizeof(kSocketPrefix) - 1;
+
+    char target[64];
+    const ssize_t len = readlink(linkPath, target, sizeof(target) - 1);
+    if (len <= ssize_t(prefixLength) || memcmp(target, kSocketPrefix, prefixLength) != 0) {
+        return 0;
+    }
+    target[len] = '\0';
+    return strtoull(target + prefixLength, nullptr, 10);
+}
+#endif
+
+QString formatEndpoint(const quint8 *address, quint16 port, bool ipv6)
+{
+    if (ipv6) {
+        return QString("[%1]:%2").arg(QHostAddress(address).toString()).arg(port);
+    }
+    const quint32 ipv4 = (quint32(address[0]) << 24) | (quint32(address[1]) << 16) |
+                         (quint32(address[2]) << 8) | quint32(address[3]);
+    return QString("%1:%2").arg(QHostAddress(ipv4).toString()).arg(port);
+}
+}
+
+bool SocketEntry::isListening() const
+{
+    return isTcp() ? state == kTcpListen : (state == kUdpUnconnected && remotePort == 0);
+}
+
+QString SocketEntry::protocolName() const
+{
+    switch (protocol) {
+        case Tcp:
+            return QStringLiteral("TCP");
+        case Tcp6:
+            return QStringLiteral("TCP6");
+        case Udp:
+            return QStringLiteral("UDP");
+        case Udp6:
+            return QStringLiteral("UDP6");
+    }
+    return QString();
+}
+
+QString SocketEntry::stateName() const
+{
+    if (!isTcp()) {
+        return isListening() ? QStringLiteral("UNCONN") : QStringLiteral("ESTAB");
+    }
+
+    static const char *const names[] = {
+        "UNKNOWN", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2",
+        "TIME_WAIT", "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING", "NEW_SYN_RECV"
+    };
+    return QString::fromLatin1(state < sizeof(names) / sizeof(names[0]) ? names[state] : names[0]);
+}
+
+QString SocketEntry::localEndpoint() const
+{
+    return formatEndpoint(localAddress, localPort, isIpv6());
+}
+
+QString SocketEntry::remoteEndpoint() const
+{
+    return formatEndpoint(remoteAddress, remotePort, isIpv6());
+}
+
+QString SocketEntry::describe() const
+{
+    if (isListening()) {
+        return QString("%1 %2 %3").arg(protocolName(), localEndpoint(), stateName());
+    }
+    return QString("%1 %2 -> %3 %4").arg(protocolName(), localEndpoint(), remoteEndpoint(), stateName()) +
+           QString::fromUtf8(" 发送队列 %1 / 接收队列 %2").arg(sendQueue).arg(receiveQueue);
+}
+
+SocketScanner::SocketScanner(quint16 port)
+    : targetPort(port)
+{
+}
+
+void SocketScanner::setProcessFilter(const QString &processNameOrPid)
+{
+    processFilter = processNameOrPid;
+    filterPid = processNameOrPid.toULong(&filterIsPid);
+}
+
+bool SocketScanner::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return access("/proc/net/tcp", R_OK) == 0 && access("/proc/self/fd", R_OK | X_OK) == 0;
+#else
+    return false;
+#endif
+}
+
+QVector<SocketEntry> SocketScanner::readSocketTable(quint32 stateMask, Backend *backend)
+{
+    QVector<SocketEntry> entries;
+#ifdef Q_OS_LINUX
+    const Backend used = forEachSocket(stateMask, [&entries](const SocketEntry &entry) {
+        entries.append(entry);
+    });
+    if (backend) {
+        *backend = used;
+    }
+#else
+    Q_UNUSED(stateMask);
+    if (backend) {
+        *backend = Procfs;
+    }
+#endif
+    return entries;
+}
+
+bool SocketScanner::wanted(const SocketEntry &entry) const
+{
+    if (targetPort == 0) {
+        return entry.isListening();
+    }
+    return entry.localPort == targetPort || entry.remotePort == targetPort;
+}
+
+void SocketScanner::scan(const MatchCallback &onMatch)
+{
+    sockets = 0;
+    matched = 0;
+    orphans = 0;
+    processCount = 0;
+    deniedCount = 0;
+    elapsed = 0;
+
+#ifdef Q_OS_LINUX
+    QElapsedTimer timer;
+    timer.start();
+
+    if (processFilter.isEmpty()) {
+        scanPort(onMatch);
+    } else {
+        scanProcesses(onMatch);
+    }
+
+    elapsed = timer.elapsed();
+#else
+    Q_UNUSED(onMatch);
+#endif
+}
+
+// 端口模式：先取套接字表并按端口过滤，再遍历所有进程的 fd 做连接
+void SocketScanner::scanPort(const MatchCallback &onMatch)
+{
+#ifdef Q_OS_LINUX
+    // 只查监听端口时由内核过滤掉其余状态的套接字
+    const quint32 stateMask = targetPort == 0
+        ? (1u << kTcpListen) | (1u << kUdpUnconnected)
+        : kAllStates;
+
+    // 1. 端口过滤先于连接执行，哈希表只保存需要的套接字
+    QVector<SocketEntry> candidates;
+    QHash<quint64, int> byInode;
+    usedBackend = forEachSocket(stateMask, [this, &candidates, &byInode](const SocketEntry &entry) {
+        ++sockets;
+        if (!wanted(entry)) {
+            return;
+        }
+        if (entry.inode == 0) {
+            ++orphans;
+            return;
+        }
+        if (!byInode.contains(entry.inode)) {
+            byInode.insert(entry.inode, candidates.size());
+            candidates.append(entry);
+        }
+    });
+
+    if (candidates.isEmpty()) {
+        return;
+    }
+
+    // 2. 遍历一次所有进程的 fd，按 inode 哈希连接
+    DIR *procDir = opendir("/proc");
+    if (!procDir) {
+        return;
+    }
+
+    ProcessInfoCache &processInfo = ProcessInfoCache::shared();
+    processInfo.beginScan();
+
+    QVector<quint8> owned(candidates.size(), 0);
+    int ownedCount = 0;
+    char fdDirPath[64];
+    char linkPath[96];
+
+    while (struct dirent *entry = readdir(procDir)) {
+        if (cancelFlag && cancelFlag->loadAcquire()) {
+            break;
+        }
+        if (!isPidName(entry->d_name)) {
+            continue;
+        }
+        ++processCount;
+
+        snprintf(fdDirPath, sizeof(fdDirPath), "/proc/%s/fd", entry->d_name);
+        DIR *fdDir = opendir(fdDirPath);
+        if (!fdDir) {
+            if (errno == EACCES || errno == EPERM) {
+                ++deniedCount;
+            }
+            continue;
+        }
+
+        const ProcessId pid = strtoul(entry->d_name, nullptr, 10);
+        while (struct dirent *fdEntry = readdir(fdDir)) {
+            if (fdEntry->d_name[0] == '.') {
+                continue;
+            }
+            snprintf(linkPath, sizeof(linkPath), "%s/%s", fdDirPath, fdEntry->d_name);
+            const quint64 inode = socketInode(linkPath);
+            const int index = inode ? byInode.value(inode, -1) : -1;
+            if (index < 0) {
+                continue;
+            }
+
+            Match match;
+            match.socket = candidates.at(index);
+            match.pid = pid;
+            const ProcessInfo info = processInfo.lookup(pid, ProcessInfo::Name | ProcessInfo::ExePath);
+            match.processName = info.name.isEmpty() ? QString::fromUtf8("未知") : info.name;
+            match.exePath = info.exePath;
+            if (!owned.at(index)) {
+                owned[index] = 1;
+                ++ownedCount;
+            }
+            ++matched;
+            onMatch(match);
+        }
+        closedir(fdDir);
+    }
+    closedir(procDir);
+
+    // 无权限访问的进程持有的套接字也计为无归属
+    orphans += candidates.size() - ownedCount;
+#else
+    Q_UNUSED(onMatch);
+#endif
+}
+
+// 连接表模式：先只遍历目标进程的 fd 收集套接字 inode，再流式过滤套接字表，
+// 哈希表大小只与目标进程持有的套接字数有关，与系统中的连接总数无关
+void SocketScanner::scanProcesses(const MatchCallback &onMatch)
+{
+#ifdef Q_OS_LINUX
+    DIR *procDir = opendir("/proc");
+    if (!procDir) {
+        return;
+    }
+
+    ProcessInfoCache &processInfo = ProcessInfoCache::shared();
+    processInfo.beginScan();
+
+    struct Owner {
+        ProcessId pid;
+        QString name;
+        QString exePath;
+    };
+    QVector<Owner> owners;
+    QHash<quint64, QVector<int>> ownersByInode;
+    char fdDirPath[64];
+    char linkPath[96];
+
+    while (struct dirent *entry = readdir(procDir)) {
+        if (cancelFlag && cancelFlag->loadAcquire()) {
+            closedir(procDir);
+            return;
+        }
+        if (!isPidName(entry->d_name)) {
+            continue;
+        }
+
+        const ProcessId pid = strtoul(entry->d_name, nullptr, 10);
+        if (filterIsPid ? pid != filterPid
+                        : !processInfo.name(pid).contains(processFilter, Qt::CaseInsensitive)) {
+            continue;
+        }
+        ++processCount;
+
+        snprintf(fdDirPath, sizeof(fdDirPath), "/proc/%s/fd", entry->d_name);
+        DIR *fdDir = opendir(fdDirPath);
+        if (!fdDir) {
+            if (errno == EACCES || errno == EPERM) {
+                ++deniedCount;
+            }
+            continue;
+        }
+
+        const int ownerIndex = owners.size();
+        bool hasSockets = false;
+        while (struct dirent *fdEntry = readdir(fdDir)) {
+            if (fdEntry->d_name[0] == '.') {
+                continue;
+            }
+            snprintf(linkPath, sizeof(linkPath), "%s/%s", fdDirPath, fdEntry->d_name);
+            const quint64 inode = socketInode(linkPath);
+            if (inode) {
+                QVector<int> &holders = ownersByInode[inode];
+                if (holders.isEmpty() || holders.last() != ownerIndex) {
+                    holders.append(ownerIndex);
+                }
+                hasSockets = true;
+            }
+        }
+        closedir(fdDir);
+
+        if (hasSockets) {
+            const ProcessInfo info = processInfo.lookup(pid, ProcessInfo::Name | ProcessInfo::ExePath);
+            Owner owner;
+            owner.pid = pid;
+            owner.name = info.name.isEmpty() ? QString::fromUtf8("未知") : info.name;
+            owner.exePath = info.exePath;
+            owners.append(owner);
+        }
+    }
+    closedir(procDir);
+
+    if (ownersByInode.isEmpty()) {
+        return;
+    }
+
+    usedBackend = forEachSocket(kAllStates, [this, &owners, &ownersByInode, &onMatch](const SocketEntry &entry) {
+        ++sockets;
+        QHash<quint64, QVector<int>>::const_iterator it = ownersByInode.constFind(entry.inode);
+        if (entry.inode == 0 || it == ownersByInode.constEnd()) {
+            return;
+        }
+        for (int ownerIndex : it.value()) {
+            const Owner &owner = owners.at(ownerIndex);
+            Match match;
+            match.socket = entry;
+            match.pid = owner.pid;
+            match.processName = owner.name;
+            match.exePath = owner.exePath;
+            ++matched;
+            onMatch(match);
+        }
+    });
+#else
+    Q_UNUSED(onMatch);
+#endif
+}
@@ -0,0 +1,105 @@
+#ifndef SOCKETSCANNER_H
+#define SOCKETSCANNER_H
+
+#include <QAtomicInt>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+#include "processtypes.h"
+
+// /proc/net/{tcp,tcp6,udp,udp6} 中的一个套接字
+struct SocketEntry {
+    enum Protocol { Tcp, Tcp6, Udp, Udp6 };
+
+    Protocol protocol = Tcp;
+    quint8 localAddress[16] = {};   // 网络字节序，IPv4 只使用前 4 字节
+    quint8 remoteAddress[16] = {};
+    quint16 localPort = 0;
+    quint16 remotePort = 0;
+    quint8 state = 0;               // 内核 TCP 状态编号
+    quint32 sendQueue = 0;          // 监听套接字为最大积压连接数
+    quint32 receiveQueue = 0;       // 监听套接字为当前等待 accept 的连接数
+    uint uid = 0;
+    quint64 inode = 0;              // 0 表示没有进程持有（如 TIME_WAIT）
+
+    bool isIpv6() const { return protocol == Tcp6 || protocol == Udp6; }
+    bool isTcp() const { return protocol == Tcp || protocol == Tcp6; }
+    // TCP 处于 LISTEN 状态，或 UDP 未连接到对端
+    bool isListening() const;
+
+    QString protocolName() const;
+    QString stateName() const;
+    QString localEndpoint() const;
+    QString remoteEndpoint() const;
+    // 例如 "TCP 0.0.0.0:8443 LISTEN" 或
+    // "TCP 10.0.0.1:22 -> 10.0.0.2:51234 ESTABLISHED 发送队列 0 / 接收队列 0"
+    QString describe() const;
+};
+
+// 套接字到进程的查询。套接字表优先通过 NETLINK_SOCK_DIAG 二进制接口获取，
+// 状态过滤在内核中完成；netlink 不可用时回退到解析 /proc/net 文本文件。
+// 套接字与进程之间按 inode 哈希连接 /proc/<pid>/fd 中的 socket:[inode] 链接，
+// 代价为 O(套接字数 + fd 数)，不做嵌套循环。目前仅支持 Linux。
+class SocketScanner
+{
+public:
+    struct Match {
+        SocketEntry socket;
+        ProcessId pid = 0;
+        QString processName;
+        QString exePath;
+    };
+
+    enum Backend { Netlink, Procfs, Mixed };
+
+    // TCP 状态位掩码，按 1 << 状态编号 组合
+    static const quint32 kAllStates = 0xffffffffu;
+
+    // port 为 0 时列出所有监听中的套接字，否则匹配本地或远端端口为 port 的套接字
+    explicit SocketScanner(quint16 port = 0);
+
+    // 连接表模式：只列出指定进程（名称包含关系或 PID）持有的全部套接字，忽略端口条件
+    void setProcessFilter(const QString &processNameOrPid);
+
+    static bool isSupported();
+
+    // 读取套接字表，只返回状态位于 stateMask 中的套接字
+    static QVector<SocketEntry> readSocketTable(quint32 stateMask = kAllStates,
+                                                Backend *backend = nullptr);
+
+    typedef std::function<void(const Match &)> MatchCallback;
+
+    void setCancelFlag(const QAtomicInt *flag) { cancelFlag = flag; }
+    void scan(const MatchCallback &onMatch);
+
+    // 最近一次扫描的统计信息
+    int socketCount() const { return sockets; }
+    int matchedSockets() const { return matched; }
+    int orphanSockets() const { return orphans; }
+    int scannedProcesses() const { return processCount; }
+    int deniedProcesses() const { return deniedCount; }
+    qint64 elapsedMs() const { return elapsed; }
+    Backend backend() const { return usedBackend; }
+
+private:
+    bool wanted(const SocketEntry &entry) const;
+    void scanPort(const MatchCallback &onMatch);
+    void scanProcesses(const MatchCallback &onMatch);
+
+    quint16 targetPort;
+    QString processFilter;
+    bool filterIsPid = false;
+    ProcessId filterPid = 0;
+    Backend usedBackend = Procfs;
+    const QAtomicInt *cancelFlag = nullptr;
+    int sockets = 0;
+    int matched = 0;
+    int orphans = 0;
+    int processCount = 0;
+    int deniedCount = 0;
+    qint64 elapsed = 0;
+};
+
+#endif // SOCKETSCANNER_H